@@ -0,0 +1,56 @@
+# Groups the output of `nm -S -C` by memory region of the STM32H750 on the
+# Daisy Seed and prints every object with its size, largest first within
+# each region. Usage: arm-none-eabi-nm -S -C --size-sort build/app.elf |
+#                     awk -f scripts/memory_report.awk
+
+function hex2dec(h,    i, c, v)
+{
+    v = 0
+    h = tolower(h)
+    for(i = 1; i <= length(h); i++)
+    {
+        c = index("0123456789abcdef", substr(h, i, 1)) - 1
+        v = v * 16 + c
+    }
+    return v
+}
+
+function region(addr,    p)
+{
+    p = tolower(substr(addr, length(addr) - 7, 2))
+    if(p == "20") return "DTCM"
+    if(p == "24") return "SRAM (AXI)"
+    if(p == "30") return "SRAM (D2)"
+    if(p == "38") return "SRAM (D3)"
+    if(p == "c0" || p == "c1" || p == "c2" || p == "c3") return "SDRAM"
+    return ""
+}
+
+# Only sized data symbols: B/b (bss), D/d (data)
+NF >= 4 && $3 ~ /^[BbDd]$/ {
+    r = region($1)
+    if(r == "")
+        next
+    name = $4
+    for(i = 5; i <= NF; i++)
+        name = name " " $i
+    size = hex2dec($2)
+    n = ++count[r]
+    sizes[r, n] = size
+    names[r, n] = name
+    total[r] += size
+}
+
+END {
+    split("DTCM,SRAM (AXI),SRAM (D2),SRAM (D3),SDRAM", order, ",")
+    for(o = 1; o <= 5; o++)
+    {
+        r = order[o]
+        if(!(r in total))
+            continue
+        printf("%s: %d bytes\n", r, total[r])
+        # nm --size-sort lists ascending; print descending
+        for(n = count[r]; n >= 1; n--)
+            printf("  %10d  %s\n", sizes[r, n], names[r, n])
+    }
+}
@@ -0,0 +1,231 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#include "alloc_guard.h"
+
+#ifdef AULOS_ALLOC_GUARD
+
+#include <cerrno>
+#include <cstddef>
+#include <new>
+
+volatile bool alloc_guard_armed = false;
+
+// Provided by the linker for --wrap=malloc,--wrap=calloc,...
+extern "C" void *__real_malloc(size_t size);
+extern "C" void *__real_calloc(size_t n, size_t size);
+extern "C" void *__real_realloc(void *ptr, size_t size);
+extern "C" void  __real_free(void *ptr);
+extern "C" void *__real_memalign(size_t alignment, size_t size);
+
+static inline void CheckHeapAccess()
+{
+    if(alloc_guard_armed)
+        __builtin_trap();
+}
+
+extern "C" void *__wrap_malloc(size_t size)
+{
+    CheckHeapAccess();
+    return __real_malloc(size);
+}
+
+extern "C" void *__wrap_calloc(size_t n, size_t size)
+{
+    CheckHeapAccess();
+    return __real_calloc(n, size);
+}
+
+extern "C" void *__wrap_realloc(void *ptr, size_t size)
+{
+    CheckHeapAccess();
+    return __real_realloc(ptr, size);
+}
+
+extern "C" void __wrap_free(void *ptr)
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+// The aligned allocators all land on memalign, which both newlib and
+// glibc provide; newlib has no posix_memalign of its own.
+extern "C" void *__wrap_memalign(size_t alignment, size_t size)
+{
+    CheckHeapAccess();
+    return __real_memalign(alignment, size);
+}
+
+extern "C" void *__wrap_aligned_alloc(size_t alignment, size_t size)
+{
+    CheckHeapAccess();
+    return __real_memalign(alignment, size);
+}
+
+extern "C" int __wrap_posix_memalign(void **ptr, size_t alignment, size_t size)
+{
+    CheckHeapAccess();
+    if(alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+    void *p = __real_memalign(alignment, size);
+    if(p == nullptr)
+        return ENOMEM;
+    *ptr = p;
+    return 0;
+}
+
+void *operator new(size_t size)
+{
+    CheckHeapAccess();
+    return __real_malloc(size);
+}
+
+void *operator new[](size_t size)
+{
+    CheckHeapAccess();
+    return __real_malloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    CheckHeapAccess();
+    return __real_malloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    CheckHeapAccess();
+    return __real_malloc(size);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+// Over-aligned types, e.g. the vector lanes of FormantBank<8>. Only C++17
+// routes them through these.
+#ifdef __cpp_aligned_new
+static inline void *AlignedNew(size_t size, std::align_val_t alignment)
+{
+    CheckHeapAccess();
+    return __real_memalign(static_cast<size_t>(alignment), size ? size : 1);
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    return AlignedNew(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+    return AlignedNew(size, alignment);
+}
+
+void *operator new(size_t                size,
+                   std::align_val_t      alignment,
+                   const std::nothrow_t &) noexcept
+{
+    return AlignedNew(size, alignment);
+}
+
+void *operator new[](size_t                size,
+                     std::align_val_t      alignment,
+                     const std::nothrow_t &) noexcept
+{
+    return AlignedNew(size, alignment);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    CheckHeapAccess();
+    __real_free(ptr);
+}
+#endif
+
+#endif
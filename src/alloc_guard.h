@@ -0,0 +1,41 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+// Debug guard against heap use in the audio path. Build with
+// `make ALLOC_GUARD=1` to wrap malloc/free, the aligned allocators and
+// every operator new/delete; any allocation while the guard is armed
+// traps immediately.
+#ifdef AULOS_ALLOC_GUARD
+extern volatile bool alloc_guard_armed;
+#define ALLOC_GUARD_ARM() (alloc_guard_armed = true)
+#define ALLOC_GUARD_DISARM() (alloc_guard_armed = false)
+#else
+#define ALLOC_GUARD_ARM()
+#define ALLOC_GUARD_DISARM()
+#endif
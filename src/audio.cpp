@@ -0,0 +1,261 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#include "audio.h"
+#include "filter.h"
+#include "osc.h"
+#include "control.h"
+#include "env.h"
+#include "fx.h"
+#include "tuning.h"
+#include "saturator.h"
+#include "pan.h"
+#include "conv.h"
+#include "budget.h"
+#include "alloc_guard.h"
+
+using namespace daisy;
+
+float osc1_formant_freq      = 500.0f;  // Default center frequency (Hz)
+float osc1_formant_bw        = 100.0f;  // Default bandwidth (Hz)
+float osc1_formant_amp       = 1.0f;    // Gain on top of the make-up gain
+float osc1_formant_resonance = 0.5f;    // Resonance factor (normalized)
+float osc1_formant_mix       = 0.5f;    // Wet/dry (0 = unfiltered)
+
+float osc2_formant_freq      = 700.0f;  // Default center frequency (Hz)
+float osc2_formant_bw        = 120.0f;  // Default bandwidth (Hz)
+float osc2_formant_amp       = 1.0f;    // Gain on top of the make-up gain
+float osc2_formant_resonance = 0.5f;    // Resonance factor (normalized)
+float osc2_formant_mix       = 0.5f;    // Wet/dry (0 = unfiltered)
+
+// Per-block envelope output, consumed by the VCA
+static float DTCM_MEM_SECTION osc1_env_buf[MAX_BLOCK_SIZE];
+static float DTCM_MEM_SECTION osc2_env_buf[MAX_BLOCK_SIZE];
+
+// Per-partial block buffers, mixed to stereo by the spreaders
+static float DTCM_MEM_SECTION osc1_partials[TOTAL_OSCS][MAX_BLOCK_SIZE];
+static float DTCM_MEM_SECTION osc2_partials[TOTAL_OSCS][MAX_BLOCK_SIZE];
+
+// Per-voice stereo buffers
+static float DTCM_MEM_SECTION osc1_left[MAX_BLOCK_SIZE];
+static float DTCM_MEM_SECTION osc1_right[MAX_BLOCK_SIZE];
+static float DTCM_MEM_SECTION osc2_left[MAX_BLOCK_SIZE];
+static float DTCM_MEM_SECTION osc2_right[MAX_BLOCK_SIZE];
+
+// Voice 1 mono sum and the phase offsets it drives into voice 2
+static float DTCM_MEM_SECTION osc1_mono[MAX_BLOCK_SIZE];
+static float DTCM_MEM_SECTION osc2_phase_mod[MAX_BLOCK_SIZE];
+
+static_assert(sizeof(osc1_env_buf) + sizeof(osc2_env_buf)
+                      + sizeof(osc1_partials) + sizeof(osc2_partials)
+                      + sizeof(osc1_left) + sizeof(osc1_right)
+                      + sizeof(osc2_left) + sizeof(osc2_right)
+                      + sizeof(osc1_mono) + sizeof(osc2_phase_mod)
+                  <= BUDGET_DTCM_BLOCK_BUFFERS,
+              "block buffers over budget");
+
+static float *const formant_lanes[FORMANT_LANES]
+    = {osc1_left, osc1_right, osc2_left, osc2_right};
+
+// Body impulse response, transformed into the convolver at init
+static float body_ir[Convolver::MAX_IR_LENGTH];
+
+void InitAudio(float sr, uint32_t seed)
+{
+    // Init formant filter bank, one lane per voice channel
+    formant_bank.Init(sr);
+    for(int lane = FORMANT_LANE_OSC1_L; lane <= FORMANT_LANE_OSC1_R; lane++)
+    {
+        formant_bank.SetLane(lane,
+                             osc1_formant_freq,
+                             osc1_formant_bw,
+                             osc1_formant_resonance,
+                             osc1_formant_amp);
+        formant_bank.SetMix(lane, osc1_formant_mix);
+    }
+    for(int lane = FORMANT_LANE_OSC2_L; lane <= FORMANT_LANE_OSC2_R; lane++)
+    {
+        formant_bank.SetLane(lane,
+                             osc2_formant_freq,
+                             osc2_formant_bw,
+                             osc2_formant_resonance,
+                             osc2_formant_amp);
+        formant_bank.SetMix(lane, osc2_formant_mix);
+    }
+
+    // Init oscillators
+    InitOscillatorArrays(sr, seed);
+
+    // Init tunings (tables are rebuilt on every scale/mixture change)
+    osc1_tuning.Init(sr);
+    osc1_tuning.SetScale(osc1_scale);
+    osc1_tuning.SetMixture(osc1_mixture);
+    osc1_tuning.SetHysteresis(osc1_pitch_hysteresis);
+
+    osc2_tuning.Init(sr);
+    osc2_tuning.SetScale(osc2_scale);
+    osc2_tuning.SetMixture(osc2_mixture);
+    osc2_tuning.SetHysteresis(osc2_pitch_hysteresis);
+
+    // Init ADSR envelopes
+    osc1_env.Init(sr);
+    osc1_env.SetTime(ENV_SEG_ATTACK, 0.01f); // Quick attack
+    osc1_env.SetTime(ENV_SEG_DECAY,  0.1f);
+    osc1_env.SetTime(ENV_SEG_RELEASE, 0.5f);
+    osc1_env.SetSustainLevel(0.7f);
+    osc1_env.SetShape(osc1_envelope_shape);
+
+    osc2_env.Init(sr);
+    osc2_env.SetTime(ENV_SEG_ATTACK, 0.01f);
+    osc2_env.SetTime(ENV_SEG_DECAY,  0.1f);
+    osc2_env.SetTime(ENV_SEG_RELEASE, 0.5f);
+    osc2_env.SetSustainLevel(0.7f);
+    osc2_env.SetShape(osc2_envelope_shape);
+
+    // Init stereo spreaders
+    osc1_spread.Init(sr);
+    osc1_spread.SetCenter(osc1_pan);
+    osc1_spread.SetWidth(stereo_width);
+    osc1_spread.SetDrift(pan_drift_depth, pan_drift_rate);
+    osc1_spread.SetLaw(pan_law);
+
+    osc2_spread.Init(sr);
+    osc2_spread.SetCenter(osc2_pan);
+    osc2_spread.SetWidth(stereo_width);
+    osc2_spread.SetDrift(pan_drift_depth, pan_drift_rate);
+    osc2_spread.SetLaw(pan_law);
+
+    // Init body resonance
+    MakeBodyImpulse(body_ir, body_ir_length, sr);
+    body_convolver.Init();
+    body_convolver.SetImpulse(body_ir, body_ir_length);
+    SetBodyMix(body_mix);
+
+    // Init send effects (delay lines live in SDRAM)
+    fx.Init(sr);
+    fx.SetDelaySend(fx_delay_send);
+    fx.SetReverbSend(fx_reverb_send);
+    fx.Delay().SetTime(fx_delay_time);
+    fx.Delay().SetFeedback(fx_delay_feedback);
+    fx.Reverb().SetDecay(fx_reverb_decay);
+    fx.Reverb().SetDamping(fx_reverb_damping);
+
+    // Init output limiter/saturator
+    output_saturator.Init(sr);
+    output_saturator.SetMode(output_sat_mode);
+    output_saturator.SetDrive(output_drive);
+    output_saturator.SetCeiling(output_ceiling);
+    output_saturator.SetOversampling(output_oversample);
+}
+
+// -------------------------------------------------
+// AudioCallback
+// -------------------------------------------------
+void AudioCallback(AudioHandle::InputBuffer  in,
+                   AudioHandle::OutputBuffer out,
+                   size_t                    size)
+{
+    // Nothing below may touch the heap
+    ALLOC_GUARD_ARM();
+
+    // Update hardware pots/CVs. Only parameters whose pots moved are
+    // recomputed, including the oscillator frequencies.
+    UpdateControls(hw);
+
+    static const float sub_weights[TOTAL_OSCS] = {1.0f, 0.4f, 0.3f, 0.2f, 0.1f};
+
+    for(size_t offset = 0; offset < size; offset += MAX_BLOCK_SIZE)
+    {
+        size_t chunk = NextChunk(size - offset);
+        float *left  = out[0] + offset;
+        float *right = out[1] + offset;
+
+        // Render envelopes-FIXME by implementing trigger/open gate logic
+        osc1_env.ProcessBlock(osc1_env_buf, chunk, true);
+        osc2_env.ProcessBlock(osc2_env_buf, chunk, true);
+
+        // Render each partial, crossfaded by morph factors and weighted
+        for(int i = 0; i < TOTAL_OSCS; i++)
+            RenderPartial(osc1_sine[i], osc1_saw[i], osc1_morph,
+                          sub_weights[i], nullptr, osc1_partials[i], chunk);
+
+        // Voice 1 is the modulator for voice 2
+        for(size_t n = 0; n < chunk; n++)
+        {
+            float sum = 0.f;
+            for(int i = 0; i < TOTAL_OSCS; i++)
+                sum += osc1_partials[i][n];
+            osc1_mono[n]      = sum;
+            osc2_phase_mod[n] = sum * osc2_fm_index;
+        }
+        const float *pm = (osc2_fm_index != 0.f) ? osc2_phase_mod : nullptr;
+
+        for(int i = 0; i < TOTAL_OSCS; i++)
+            RenderPartial(osc2_sine[i], osc2_square[i], osc2_morph,
+                          sub_weights[i], pm, osc2_partials[i], chunk);
+
+        // Pan every partial into the voice's stereo image
+        osc1_spread.Process(osc1_partials, osc1_left, osc1_right, chunk);
+        osc2_spread.Process(osc2_partials, osc2_left, osc2_right, chunk);
+
+        // Ring modulation of voice 2 by voice 1
+        if(osc2_ring_mix > 0.f)
+        {
+            for(size_t n = 0; n < chunk; n++)
+            {
+                float g = 1.f - osc2_ring_mix + osc2_ring_mix * osc1_mono[n];
+                osc2_left[n] *= g;
+                osc2_right[n] *= g;
+            }
+        }
+
+        // Formant filtering, all four voice channels in one pass. Each
+        // voice is blended with its dry signal by its formant mix.
+        formant_bank.Process(formant_lanes, chunk);
+
+        // Apply envelope and volume, sum the voices
+        for(size_t n = 0; n < chunk; n++)
+        {
+            float g1 = osc1_env_buf[n] * osc1_volume;
+            float g2 = osc2_env_buf[n] * osc2_volume;
+            left[n]  = osc1_left[n] * g1 + osc2_left[n] * g2;
+            right[n] = osc1_right[n] * g1 + osc2_right[n] * g2;
+        }
+    }
+
+    // Instrument body resonance on the filtered voices
+    if(body_enabled)
+        body_convolver.Process(out[0], out[1], size);
+
+    // Delay and reverb returns are summed onto the dry signal
+    fx.Process(out[0], out[1], size);
+
+    // Bound the output before it reaches the codec
+    output_saturator.Process(out[0], out[1], size);
+
+    ALLOC_GUARD_DISARM();
+}
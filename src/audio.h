@@ -0,0 +1,46 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include "daisy_seed.h"
+#include "osc.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Hardware object, owned by main.cpp (or by the host test harness)
+extern daisy::DaisySeed hw;
+
+// Initializes every DSP stage and pushes the default parameters. `seed`
+// picks the oscillator start phases. Not real-time safe; call once
+// before starting audio.
+void InitAudio(float sr, uint32_t seed = DEFAULT_PHASE_SEED);
+
+void AudioCallback(daisy::AudioHandle::InputBuffer  in,
+                   daisy::AudioHandle::OutputBuffer out,
+                   size_t                           size);
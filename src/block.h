@@ -0,0 +1,45 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+
+// Block size requested from the codec. Every block-processing stage keeps
+// its scratch buffers sized to MAX_BLOCK_SIZE and splits larger callbacks
+// into chunks, so the two only have to agree that MAX >= AUDIO.
+static constexpr size_t AUDIO_BLOCK_SIZE = 48;
+static constexpr size_t MAX_BLOCK_SIZE   = 64;
+
+static_assert(AUDIO_BLOCK_SIZE <= MAX_BLOCK_SIZE,
+              "audio block size exceeds scratch buffer size");
+
+// Length of the next chunk when `remaining` samples are left to process.
+inline size_t NextChunk(size_t remaining)
+{
+    return remaining < MAX_BLOCK_SIZE ? remaining : MAX_BLOCK_SIZE;
+}
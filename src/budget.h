@@ -0,0 +1,55 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+
+// Per-subsystem memory budgets, checked with static_assert next to the
+// state they cover. `make memory-report` lists the linked placement.
+
+// DTCM: 128KB, shared with the stack. Everything touched per sample.
+static constexpr size_t BUDGET_DTCM_OSCILLATORS   = 2 * 1024;
+static constexpr size_t BUDGET_DTCM_VOICE_STATE   = 2 * 1024;
+static constexpr size_t BUDGET_DTCM_BLOCK_BUFFERS = 8 * 1024;
+static constexpr size_t BUDGET_DTCM_OUTPUT        = 6 * 1024;
+static constexpr size_t BUDGET_DTCM_FX_STATE      = 4 * 1024;
+
+static constexpr size_t BUDGET_DTCM_TOTAL = 64 * 1024;
+
+static_assert(BUDGET_DTCM_OSCILLATORS + BUDGET_DTCM_VOICE_STATE
+                      + BUDGET_DTCM_BLOCK_BUFFERS + BUDGET_DTCM_OUTPUT
+                      + BUDGET_DTCM_FX_STATE
+                  <= BUDGET_DTCM_TOTAL,
+              "DTCM budgets leave too little room for the stack");
+
+// AXI SRAM: 512KB. Large or control-rate state.
+static constexpr size_t BUDGET_SRAM_CONVOLVER = 72 * 1024;
+static constexpr size_t BUDGET_SRAM_TUNING    = 8 * 1024;
+
+// SDRAM: 64MB. Delay lines only.
+static constexpr size_t BUDGET_SDRAM_FX = 4 * 1024 * 1024;
@@ -30,100 +30,261 @@
 #include "filter.h"
 #include "osc.h"
 #include "env.h"
+#include "tuning.h"
 
 #include <cmath>
 
 float pot_values[NUM_POTS] = {0};
 float cv_values[NUM_CV]    = {0};
+float pot_stable[NUM_POTS] = {0};
+float cv_stable[NUM_CV]    = {0};
 
 const float SMOOTHING_FACTOR = 0.1f;
 
 float osc1_envelope_shape = 0.5f; // Envelope shape (0 to 1)
 float osc2_envelope_shape = 0.5f; // Envelope shape (0 to 1)
 
-void UpdateControls(daisy::DaisySeed &hw)
+static_assert(NUM_POTS + NUM_CV <= 32, "inputs do not fit the change mask");
+
+// Root pitch span of the exponential 20Hz-5kHz mapping, 12 * log2(250)
+static constexpr float ROOT_SPAN_SEMITONES = 95.59f;
+
+// Root dead-band: 0.02 semitones, converted to pot units. The mapping is
+// exponential, so the band is the same pitch step anywhere on the pot,
+// and at about 14 steps of a 16-bit ADC it clears the converter noise.
+static constexpr float ROOT_DEADBAND = 0.02f / ROOT_SPAN_SEMITONES;
+
+// Dead-band each pot must leave before a change event is emitted, in pot
+// units.
+static const float pot_deadband[NUM_POTS] = {
+    ROOT_DEADBAND, // POT_OSC1_ROOT
+    0.004f,        // POT_OSC1_MORPH
+    0.004f,        // POT_OSC1_FORMANT_FREQ
+    0.004f,        // POT_OSC1_FORMANT_BW
+    0.004f,        // POT_OSC1_FORMANT_RES
+    0.004f,        // POT_OSC1_ENVELOPE
+    ROOT_DEADBAND, // POT_OSC2_ROOT
+    0.004f,        // POT_OSC2_MORPH
+    0.004f,        // POT_OSC2_FORMANT_FREQ
+    0.004f,        // POT_OSC2_FORMANT_BW
+    0.004f,        // POT_OSC2_FORMANT_RES
+    0.004f,        // POT_OSC2_ENVELOPE
+};
+
+// Every CV destination is an amount
+static constexpr float CV_DEADBAND = 0.004f;
+
+// Offset and noise around 0V that still reads as "off"
+static constexpr float CV_ZERO_ZONE = 0.02f;
+
+#define POT_BIT(p) (1u << (p))
+#define CV_BIT(c) (1u << (NUM_POTS + (c)))
+
+static constexpr uint32_t ALL_INPUTS = (1u << (NUM_POTS + NUM_CV)) - 1;
+
+// Events not yet consumed; everything starts dirty so the first callback
+// pushes a complete parameter set.
+static uint32_t pending_changes = ALL_INPUTS;
+
+// Root frequency in Hz (20Hz - 5000Hz), exponential: equal pot travel
+// is an equal pitch interval
+static float MapRootFreq(float k)
 {
-    // Read from multiplexers into pot_values[], cv_values[]
-    ReadMultiplexers(hw);
+    float minF = 20.f;
+    return minF * exp2f(ROOT_SPAN_SEMITONES / 12.f * k);
+}
 
-    // osc1
-    float k0 = pot_values[0]; // Root frequency
-    float k1 = pot_values[1]; // Morph
-    float k2 = pot_values[2]; // Formant frequency
-    float k3 = pot_values[3]; // Formant bandwidth
-    float k4 = pot_values[4]; // Formant resonance
-    float k5 = pot_values[5]; // Envelope
-    // osc2
-    float k6 = pot_values[0]; // Root frequency
-    float k7 = pot_values[1]; // Morph
-    float k8 = pot_values[2]; // Formant frequency
-    float k9 = pot_values[3]; // Formant bandwidth
-    float k10 = pot_values[4]; // Formant resonance
-    float k11 = pot_values[5]; // Envelope
-
-    // Root frequency in Hz (20Hz - 5000Hz)
-    {
-        float minF = 20.f;
-        float maxF = 5000.f;
-        // osc1
-        osc1_root_freq = minF + (maxF - minF) * k0;
-        // osc2
-        osc2_root_freq = minF + (maxF - minF) * k6;
-    }
+// Formant Frequency (100Hz - 5000Hz)
+static float MapFormantFreq(float k)
+{
+    float minF = 100.f;
+    float maxF = 5000.f;
+    return minF + (maxF - minF) * k;
+}
 
-    // Morph (0 to 1)
-    {
-        // osc1
-        osc1_morph = k1;
-        osc1_morph = fmaxf(0.f, fminf(osc1_morph, 1.f));
-        // osc2
-        osc2_morph = k7;
-        osc2_morph = fmaxf(0.f, fminf(osc2_morph, 1.f));
-    }
+// Formant Bandwidth (50Hz - 1000Hz)
+static float MapFormantBandwidth(float k)
+{
+    float minBW = 50.f;
+    float maxBW = 1000.f;
+    return minBW + (maxBW - minBW) * k;
+}
 
-    // Formant Frequency (100Hz - 5000Hz)
-    {
-        float minF = 100.f;
-        float maxF = 5000.f;
-        // osc1
-        osc1_formant_freq = minF + (maxF - minF) * k2;
-        osc1_formant_filter.SetFreq(osc1_formant_freq);
-        // osc2
-        osc2_formant_freq = minF + (maxF - minF) * k8;
-        osc2_formant_filter.SetFreq(osc2_formant_freq);
-    }
+// Resonance Factor (1.0 - 10.0)
+static float MapResonance(float k)
+{
+    float minR = 1.0f;
+    float maxR = 10.0f;
+    return minR + (maxR - minR) * k;
+}
+
+// Unit range (0 to 1)
+static float MapUnit(float k)
+{
+    return fmaxf(0.f, fminf(k, 1.f));
+}
+
+// CV amount (0 to 1) from 0V to full positive swing. An unpatched jack
+// reads 0V and leaves its destination off; so does a front end that
+// rests at the bottom of the ADC range instead of mid-scale.
+static float MapCvAmount(float k)
+{
+    float volts = 2.f * (k - CV_REST);
+    return MapUnit((volts - CV_ZERO_ZONE) / (1.f - CV_ZERO_ZONE));
+}
+
+// -------------------------------------------------
+// Control graph
+// -------------------------------------------------
+// Each node recomputes one derived parameter and lists the pots it
+// depends on. Nodes only run when one of their inputs changed.
+struct ControlNode
+{
+    uint32_t inputs;
+    void (*update)();
+};
+
+static void UpdateOsc1Root()
+{
+    osc1_root_freq = MapRootFreq(pot_stable[POT_OSC1_ROOT]);
+    if(osc1_tuning.SetPitch(osc1_root_freq))
+        UpdateOsc1Frequencies();
+}
 
-    // Formant Bandwidth (50Hz - 1000Hz)
+static void UpdateOsc2Root()
+{
+    osc2_root_freq = MapRootFreq(pot_stable[POT_OSC2_ROOT]);
+    if(osc2_tuning.SetPitch(osc2_root_freq))
+        UpdateOsc2Frequencies();
+}
+
+static void UpdateOsc1Morph()
+{
+    osc1_morph = MapUnit(pot_stable[POT_OSC1_MORPH]);
+}
+
+static void UpdateOsc2Morph()
+{
+    osc2_morph = MapUnit(pot_stable[POT_OSC2_MORPH]);
+}
+
+static void UpdateOsc1Formant()
+{
+    osc1_formant_freq      = MapFormantFreq(pot_stable[POT_OSC1_FORMANT_FREQ]);
+    osc1_formant_bw        = MapFormantBandwidth(pot_stable[POT_OSC1_FORMANT_BW]);
+    osc1_formant_resonance = MapResonance(pot_stable[POT_OSC1_FORMANT_RES]);
+    for(int lane = FORMANT_LANE_OSC1_L; lane <= FORMANT_LANE_OSC1_R; lane++)
+        formant_bank.SetLane(lane,
+                             osc1_formant_freq,
+                             osc1_formant_bw,
+                             osc1_formant_resonance,
+                             osc1_formant_amp);
+}
+
+static void UpdateOsc2Formant()
+{
+    osc2_formant_freq      = MapFormantFreq(pot_stable[POT_OSC2_FORMANT_FREQ]);
+    osc2_formant_bw        = MapFormantBandwidth(pot_stable[POT_OSC2_FORMANT_BW]);
+    osc2_formant_resonance = MapResonance(pot_stable[POT_OSC2_FORMANT_RES]);
+    for(int lane = FORMANT_LANE_OSC2_L; lane <= FORMANT_LANE_OSC2_R; lane++)
+        formant_bank.SetLane(lane,
+                             osc2_formant_freq,
+                             osc2_formant_bw,
+                             osc2_formant_resonance,
+                             osc2_formant_amp);
+}
+
+static void UpdateOsc1EnvelopeShape()
+{
+    osc1_envelope_shape = MapUnit(pot_stable[POT_OSC1_ENVELOPE]);
+    osc1_env.SetShape(osc1_envelope_shape);
+}
+
+static void UpdateOsc2EnvelopeShape()
+{
+    osc2_envelope_shape = MapUnit(pot_stable[POT_OSC2_ENVELOPE]);
+    osc2_env.SetShape(osc2_envelope_shape);
+}
+
+static void UpdateOsc2FmIndex()
+{
+    osc2_fm_index = MapCvAmount(cv_stable[CV_OSC2_LIN_FM]);
+}
+
+static void UpdateOsc2RingMix()
+{
+    osc2_ring_mix = MapCvAmount(cv_stable[CV_MOD]);
+}
+
+static const ControlNode control_graph[] = {
+    {POT_BIT(POT_OSC1_ROOT), UpdateOsc1Root},
+    {POT_BIT(POT_OSC2_ROOT), UpdateOsc2Root},
+    {POT_BIT(POT_OSC1_MORPH), UpdateOsc1Morph},
+    {POT_BIT(POT_OSC2_MORPH), UpdateOsc2Morph},
+    // Frequency, bandwidth and resonance feed one coefficient update
+    {POT_BIT(POT_OSC1_FORMANT_FREQ) | POT_BIT(POT_OSC1_FORMANT_BW)
+         | POT_BIT(POT_OSC1_FORMANT_RES),
+     UpdateOsc1Formant},
+    {POT_BIT(POT_OSC2_FORMANT_FREQ) | POT_BIT(POT_OSC2_FORMANT_BW)
+         | POT_BIT(POT_OSC2_FORMANT_RES),
+     UpdateOsc2Formant},
+    {POT_BIT(POT_OSC1_ENVELOPE), UpdateOsc1EnvelopeShape},
+    {POT_BIT(POT_OSC2_ENVELOPE), UpdateOsc2EnvelopeShape},
+    {CV_BIT(CV_OSC2_LIN_FM), UpdateOsc2FmIndex},
+    {CV_BIT(CV_MOD), UpdateOsc2RingMix},
+};
+
+// Compare the smoothed readings against the last stable value and emit a
+// change event for every pot that left its dead-band.
+static uint32_t DetectPotChanges()
+{
+    uint32_t changed = 0;
+    for(int i = 0; i < NUM_POTS; i++)
     {
-        float minBW = 50.f;
-        float maxBW = 1000.f;
-        // osc1
-        osc1_formant_bw = minBW + (maxBW - minBW) * k3;
-        osc1_formant_filter.SetBandwidth(osc1_formant_bw);
-        // osc2
-        osc2_formant_bw = minBW + (maxBW - minBW) * k9;
-        osc2_formant_filter.SetBandwidth(osc2_formant_bw);
+        if(fabsf(pot_values[i] - pot_stable[i]) > pot_deadband[i])
+        {
+            pot_stable[i] = pot_values[i];
+            changed |= POT_BIT(i);
+        }
     }
+    return changed;
+}
 
-    // Resonance Factor (1.0 - 10.0)
+static uint32_t DetectCvChanges()
+{
+    uint32_t changed = 0;
+    for(int i = 0; i < NUM_CV; i++)
     {
-        float minR = 1.0f;
-        float maxR = 10.0f;
-        // osc1
-        osc1_formant_resonance = minR + (maxR - minR) * k4;
-        osc1_formant_filter.SetResonance(osc1_formant_resonance);
-        // osc2
-        osc2_formant_resonance = minR + (maxR - minR) * k10;
-        osc2_formant_filter.SetResonance(osc2_formant_resonance);
+        if(fabsf(cv_values[i] - cv_stable[i]) > CV_DEADBAND)
+        {
+            cv_stable[i] = cv_values[i];
+            changed |= CV_BIT(i);
+        }
     }
+    return changed;
+}
+
+void RefreshControls()
+{
+    pending_changes = 0;
+    for(const ControlNode &node : control_graph)
+        node.update();
+}
+
+uint32_t UpdateControls(daisy::DaisySeed &hw)
+{
+    // Read from multiplexers into pot_values[], cv_values[]
+    ReadMultiplexers(hw);
+
+    uint32_t changed = DetectPotChanges() | DetectCvChanges() | pending_changes;
+    pending_changes  = 0;
+    if(changed == 0)
+        return 0;
 
-    // Envelope Shape (0 to 1)
+    for(const ControlNode &node : control_graph)
     {
-        // osc1
-        osc1_envelope_shape = k5;
-        osc1_envelope_shape = fmaxf(0.f, fminf(osc1_envelope_shape, 1.f));
-        // osc2
-        osc2_envelope_shape = k11;
-        osc2_envelope_shape = fmaxf(0.f, fminf(osc2_envelope_shape, 1.f));
+        if(node.inputs & changed)
+            node.update();
     }
-}
\ No newline at end of file
+    return changed;
+}
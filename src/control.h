@@ -25,14 +25,80 @@
 //
 // See http://creativecommons.org/licenses/MIT/ for more information.
 // ----------------------------------------------------------------------------
+#pragma once
+
 #include "daisy_seed.h"
 
+#include <cstdint>
+
 static constexpr int NUM_POTS = 12;
 static constexpr int NUM_CV   = 14;
 
+// Pot assignments
+enum
+{
+    // osc1
+    POT_OSC1_ROOT,
+    POT_OSC1_MORPH,
+    POT_OSC1_FORMANT_FREQ,
+    POT_OSC1_FORMANT_BW,
+    POT_OSC1_FORMANT_RES,
+    POT_OSC1_ENVELOPE,
+    // osc2
+    POT_OSC2_ROOT,
+    POT_OSC2_MORPH,
+    POT_OSC2_FORMANT_FREQ,
+    POT_OSC2_FORMANT_BW,
+    POT_OSC2_FORMANT_RES,
+    POT_OSC2_ENVELOPE,
+};
+
+static_assert(POT_OSC2_ENVELOPE < NUM_POTS, "pot assignment out of range");
+
+// CV jacks in multiplexer order, which follows the panel: each
+// oscillator's row of six, then the two jacks under the outputs. Only
+// jacks with a destination in this firmware have a control node.
+enum
+{
+    // osc1
+    CV_OSC1_VOCT,
+    CV_OSC1_SHAPE,
+    CV_OSC1_CUTOFF,
+    CV_OSC1_RES,
+    CV_OSC1_EXP_FM,
+    CV_OSC1_LIN_FM,
+    // osc2
+    CV_OSC2_VOCT,
+    CV_OSC2_SHAPE,
+    CV_OSC2_CUTOFF,
+    CV_OSC2_RES,
+    CV_OSC2_EXP_FM,
+    CV_OSC2_LIN_FM, // Phase modulation of osc2 by osc1
+    // output section
+    CV_MOD,         // Ring modulation of osc2 by osc1
+    CV_PHASE,
+};
+
+static_assert(CV_PHASE == NUM_CV - 1, "CV assignment does not cover the panel");
+
+// ADC reading of a CV jack at 0V. The inputs are bipolar, so 0V sits at
+// mid-scale; amounts are read from there upwards.
+static constexpr float CV_REST = 0.5f;
+
 extern float pot_values[NUM_POTS];
 extern float cv_values[NUM_CV];
 
+// Last value of each input that produced a change event
+extern float pot_stable[NUM_POTS];
+extern float cv_stable[NUM_CV];
+
 extern const float SMOOTHING_FACTOR;
 
-void UpdateControls(daisy::DaisySeed &hw);
+// Reads the multiplexers and recomputes only the parameters whose inputs
+// moved outside their dead-band. Returns the mask of changed inputs, pots
+// in the low NUM_POTS bits and CVs above them.
+uint32_t UpdateControls(daisy::DaisySeed &hw);
+
+// Recomputes every parameter from pot_stable[]/cv_stable[] without reading the
+// hardware, e.g. after restoring a snapshot.
+void RefreshControls();
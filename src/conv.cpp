@@ -0,0 +1,317 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#include "conv.h"
+#include "budget.h"
+
+#include <cmath>
+#include <cstring>
+
+static_assert(Convolver::PARTITION_SIZE >= AUDIO_BLOCK_SIZE,
+              "partition shorter than the audio block");
+static_assert(Convolver::MAX_PARTITIONS >= 1, "no room for a tail");
+
+static constexpr float TWO_PI = 6.28318530717959f;
+
+// Too large for DTCM; lives in AXI SRAM
+Convolver body_convolver;
+
+static_assert(sizeof(body_convolver) <= BUDGET_SRAM_CONVOLVER,
+              "convolver over budget");
+
+bool   body_enabled   = false;
+float  body_mix       = 0.0f;
+size_t body_ir_length = Convolver::MAX_IR_LENGTH;
+
+void SetBodyMix(float mix)
+{
+    body_mix    = fmaxf(0.f, fminf(mix, 1.f));
+    bool enable = body_mix > 0.f;
+    if(enable && !body_enabled)
+        body_convolver.Reset();
+    body_enabled = enable;
+    body_convolver.SetMix(body_mix);
+}
+
+Convolver::Convolver()
+{
+    mix_ = 0.5f;
+    Init();
+}
+
+void Convolver::Init()
+{
+    // FFT tables
+    for(size_t i = 0; i < FFT_SIZE / 2; i++)
+    {
+        cos_[i] = cosf(TWO_PI * i / FFT_SIZE);
+        sin_[i] = -sinf(TWO_PI * i / FFT_SIZE);
+    }
+    size_t bits = 0;
+    while((size_t(1) << bits) < FFT_SIZE)
+        bits++;
+    for(size_t i = 0; i < FFT_SIZE; i++)
+    {
+        size_t r = 0;
+        for(size_t b = 0; b < bits; b++)
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        bitrev_[i] = r;
+    }
+
+    head_length_    = 0;
+    num_partitions_ = 0;
+    Reset();
+}
+
+void Convolver::Reset()
+{
+    pos_     = 0;
+    fdl_pos_ = 0;
+    memset(frame_l_, 0, sizeof(frame_l_));
+    memset(frame_r_, 0, sizeof(frame_r_));
+    memset(tail_l_, 0, sizeof(tail_l_));
+    memset(tail_r_, 0, sizeof(tail_r_));
+    memset(fdl_re_, 0, sizeof(fdl_re_));
+    memset(fdl_im_, 0, sizeof(fdl_im_));
+}
+
+void Convolver::SetImpulse(const float *ir, size_t length)
+{
+    if(length > MAX_IR_LENGTH)
+        length = MAX_IR_LENGTH;
+
+    head_length_ = length < PARTITION_SIZE ? length : PARTITION_SIZE;
+    memset(head_, 0, sizeof(head_));
+    memcpy(head_, ir, head_length_ * sizeof(float));
+
+    // Tail partitions are zero padded to the FFT size and transformed
+    // once here; the 1/N of the inverse transform is folded in as well.
+    size_t tail    = length - head_length_;
+    num_partitions_ = (tail + PARTITION_SIZE - 1) / PARTITION_SIZE;
+    float scale    = 1.f / FFT_SIZE;
+    for(size_t p = 0; p < num_partitions_; p++)
+    {
+        const float *src = ir + PARTITION_SIZE * (p + 1);
+        size_t       n   = length - PARTITION_SIZE * (p + 1);
+        if(n > PARTITION_SIZE)
+            n = PARTITION_SIZE;
+
+        memset(ir_re_[p], 0, sizeof(ir_re_[p]));
+        memset(ir_im_[p], 0, sizeof(ir_im_[p]));
+        for(size_t i = 0; i < n; i++)
+            ir_re_[p][i] = src[i] * scale;
+        Fft(ir_re_[p], ir_im_[p]);
+    }
+
+    Reset();
+}
+
+void Convolver::SetMix(float mix)
+{
+    mix_ = fmaxf(0.f, fminf(mix, 1.f));
+}
+
+void Convolver::Process(float *left, float *right, size_t size)
+{
+    float dry = 1.f - mix_;
+    size_t n  = 0;
+    while(n < size)
+    {
+        // Run up to the end of the current partition
+        size_t run = PARTITION_SIZE - pos_;
+        if(run > size - n)
+            run = size - n;
+
+        float *cur_l = frame_l_ + PARTITION_SIZE + pos_;
+        float *cur_r = frame_r_ + PARTITION_SIZE + pos_;
+        memcpy(cur_l, left + n, run * sizeof(float));
+        memcpy(cur_r, right + n, run * sizeof(float));
+
+        for(size_t i = 0; i < run; i++)
+        {
+            // Direct-form head over the contiguous frame history
+            const float *xl = cur_l + i;
+            const float *xr = cur_r + i;
+            float        wl = tail_l_[pos_ + i];
+            float        wr = tail_r_[pos_ + i];
+            for(size_t j = 0; j < head_length_; j++)
+            {
+                wl += head_[j] * *(xl - j);
+                wr += head_[j] * *(xr - j);
+            }
+            left[n + i]  = left[n + i] * dry + wl * mix_;
+            right[n + i] = right[n + i] * dry + wr * mix_;
+        }
+
+        n += run;
+        pos_ += run;
+        if(pos_ == PARTITION_SIZE)
+        {
+            ProcessPartition();
+            pos_ = 0;
+        }
+    }
+}
+
+void Convolver::GetState(ConvolverState &state) const
+{
+    state.pos     = pos_;
+    state.fdl_pos = fdl_pos_;
+    memcpy(state.frame_l, frame_l_, sizeof(frame_l_));
+    memcpy(state.frame_r, frame_r_, sizeof(frame_r_));
+    memcpy(state.tail_l, tail_l_, sizeof(tail_l_));
+    memcpy(state.tail_r, tail_r_, sizeof(tail_r_));
+    memcpy(state.fdl_re, fdl_re_, sizeof(fdl_re_));
+    memcpy(state.fdl_im, fdl_im_, sizeof(fdl_im_));
+}
+
+void Convolver::SetState(const ConvolverState &state)
+{
+    pos_     = state.pos < PARTITION_SIZE ? state.pos : 0;
+    fdl_pos_ = state.fdl_pos < num_partitions_ ? state.fdl_pos : 0;
+    memcpy(frame_l_, state.frame_l, sizeof(frame_l_));
+    memcpy(frame_r_, state.frame_r, sizeof(frame_r_));
+    memcpy(tail_l_, state.tail_l, sizeof(tail_l_));
+    memcpy(tail_r_, state.tail_r, sizeof(tail_r_));
+    memcpy(fdl_re_, state.fdl_re, sizeof(fdl_re_));
+    memcpy(fdl_im_, state.fdl_im, sizeof(fdl_im_));
+}
+
+void Convolver::ProcessPartition()
+{
+    if(num_partitions_ > 0)
+    {
+        // Spectrum of the last two partitions, left in re and right in im
+        float *x_re = fdl_re_[fdl_pos_];
+        float *x_im = fdl_im_[fdl_pos_];
+        memcpy(x_re, frame_l_, sizeof(frame_l_));
+        memcpy(x_im, frame_r_, sizeof(frame_r_));
+        Fft(x_re, x_im);
+
+        // Multiply-accumulate against the frequency delay line
+        memset(acc_re_, 0, sizeof(acc_re_));
+        memset(acc_im_, 0, sizeof(acc_im_));
+        size_t slot = fdl_pos_;
+        for(size_t p = 0; p < num_partitions_; p++)
+        {
+            const float *xr = fdl_re_[slot];
+            const float *xi = fdl_im_[slot];
+            const float *hr = ir_re_[p];
+            const float *hi = ir_im_[p];
+            for(size_t k = 0; k < FFT_SIZE; k++)
+            {
+                acc_re_[k] += xr[k] * hr[k] - xi[k] * hi[k];
+                acc_im_[k] += xr[k] * hi[k] + xi[k] * hr[k];
+            }
+            slot = (slot == 0) ? num_partitions_ - 1 : slot - 1;
+        }
+
+        // Inverse transform by swapping re/im around a forward FFT.
+        // The last partition of the overlap-save frame is valid output.
+        Fft(acc_im_, acc_re_);
+        memcpy(tail_l_, acc_re_ + PARTITION_SIZE, sizeof(tail_l_));
+        memcpy(tail_r_, acc_im_ + PARTITION_SIZE, sizeof(tail_r_));
+
+        fdl_pos_ = (fdl_pos_ + 1 == num_partitions_) ? 0 : fdl_pos_ + 1;
+    }
+
+    // Current partition becomes the history for the next one
+    memcpy(frame_l_, frame_l_ + PARTITION_SIZE, PARTITION_SIZE * sizeof(float));
+    memcpy(frame_r_, frame_r_ + PARTITION_SIZE, PARTITION_SIZE * sizeof(float));
+}
+
+void Convolver::Fft(float *re, float *im) const
+{
+    // Iterative radix-2 decimation in time
+    for(size_t i = 0; i < FFT_SIZE; i++)
+    {
+        size_t j = bitrev_[i];
+        if(j > i)
+        {
+            float t = re[i];
+            re[i]   = re[j];
+            re[j]   = t;
+            t       = im[i];
+            im[i]   = im[j];
+            im[j]   = t;
+        }
+    }
+
+    for(size_t len = 2; len <= FFT_SIZE; len <<= 1)
+    {
+        size_t half   = len >> 1;
+        size_t stride = FFT_SIZE / len;
+        for(size_t start = 0; start < FFT_SIZE; start += len)
+        {
+            for(size_t k = 0; k < half; k++)
+            {
+                float wr = cos_[k * stride];
+                float wi = sin_[k * stride];
+                size_t a = start + k;
+                size_t b = a + half;
+                float tr = re[b] * wr - im[b] * wi;
+                float ti = re[b] * wi + im[b] * wr;
+                re[b]    = re[a] - tr;
+                im[b]    = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
+
+void MakeBodyImpulse(float *ir, size_t length, float sr)
+{
+    // Mode frequencies (Hz), decay times (s) and levels
+    static const float freqs[]  = {185.f, 280.f, 455.f, 720.f, 1150.f, 2350.f};
+    static const float decays[] = {0.060f, 0.045f, 0.030f, 0.020f, 0.012f, 0.006f};
+    static const float levels[] = {1.0f, 0.8f, 0.6f, 0.45f, 0.3f, 0.2f};
+    static constexpr int NUM_MODES = sizeof(freqs) / sizeof(freqs[0]);
+
+    float energy = 0.f;
+    for(size_t n = 0; n < length; n++)
+    {
+        float t = n / sr;
+        float y = 0.f;
+        for(int m = 0; m < NUM_MODES; m++)
+            y += levels[m] * expf(-t / decays[m]) * sinf(TWO_PI * freqs[m] * t);
+        ir[n] = y;
+        energy += y * y;
+    }
+
+    // Direct sound on the first tap
+    if(length > 0)
+    {
+        energy -= ir[0] * ir[0];
+        ir[0] = 1.f;
+        energy += 1.f;
+    }
+
+    float norm = 1.f / sqrtf(energy);
+    for(size_t n = 0; n < length; n++)
+        ir[n] *= norm;
+}
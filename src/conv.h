@@ -0,0 +1,129 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include "block.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Smallest power of two >= n
+constexpr size_t NextPow2(size_t n)
+{
+    return (n <= 1) ? 1 : 2 * NextPow2((n + 1) / 2);
+}
+
+struct ConvolverState;
+
+// -------------------------------------------------
+// Convolver
+// -------------------------------------------------
+// Zero-latency stereo convolution. The first partition of the impulse
+// response is applied as a direct-form FIR; the rest runs through a
+// uniformly partitioned overlap-save FFT engine whose one partition of
+// latency is exactly covered by the direct head. Left and right are
+// packed into the real and imaginary parts of a single complex FFT,
+// which works because the impulse response is real.
+class Convolver
+{
+  public:
+    // Partition size follows the audio block size
+    static constexpr size_t PARTITION_SIZE = NextPow2(AUDIO_BLOCK_SIZE);
+    static constexpr size_t FFT_SIZE       = 2 * PARTITION_SIZE;
+    // Longest power-of-two response whose worst callback stays within
+    // BODY_LOAD_BUDGET of the block period; BenchConvolver() in
+    // test/bench.cpp projects the limit from measured cost per partition.
+    static constexpr size_t MAX_IR_LENGTH  = 1024;
+    static constexpr size_t MAX_PARTITIONS
+        = MAX_IR_LENGTH / PARTITION_SIZE - 1;
+
+    Convolver();
+    void Init();
+    // Clears the input history and pending tail, keeping the IR.
+    void Reset();
+    // Splits the response into the direct head and frequency domain
+    // partitions. Not real-time safe; call outside the audio callback.
+    void SetImpulse(const float *ir, size_t length);
+    void SetMix(float mix);
+    // Processes a stereo pair in place.
+    void Process(float *left, float *right, size_t size);
+    // Input history and pending output. The impulse response is not
+    // part of the state; restore into a convolver holding the same one.
+    void GetState(ConvolverState &state) const;
+    void SetState(const ConvolverState &state);
+
+  private:
+    float mix_;
+    size_t head_length_;
+    size_t num_partitions_;
+    size_t pos_;
+    size_t fdl_pos_;
+    float head_[PARTITION_SIZE];
+    float frame_l_[FFT_SIZE]; // previous partition | current partition
+    float frame_r_[FFT_SIZE];
+    float tail_l_[PARTITION_SIZE];
+    float tail_r_[PARTITION_SIZE];
+    float ir_re_[MAX_PARTITIONS][FFT_SIZE];
+    float ir_im_[MAX_PARTITIONS][FFT_SIZE];
+    float fdl_re_[MAX_PARTITIONS][FFT_SIZE];
+    float fdl_im_[MAX_PARTITIONS][FFT_SIZE];
+    float acc_re_[FFT_SIZE];
+    float acc_im_[FFT_SIZE];
+    float cos_[FFT_SIZE / 2];
+    float sin_[FFT_SIZE / 2];
+    uint16_t bitrev_[FFT_SIZE];
+    void Fft(float *re, float *im) const;
+    void ProcessPartition();
+};
+
+struct ConvolverState
+{
+    uint32_t pos;
+    uint32_t fdl_pos;
+    float frame_l[Convolver::FFT_SIZE];
+    float frame_r[Convolver::FFT_SIZE];
+    float tail_l[Convolver::PARTITION_SIZE];
+    float tail_r[Convolver::PARTITION_SIZE];
+    float fdl_re[Convolver::MAX_PARTITIONS][Convolver::FFT_SIZE];
+    float fdl_im[Convolver::MAX_PARTITIONS][Convolver::FFT_SIZE];
+};
+
+// Fills `ir` with a synthetic instrument body response: a handful of
+// damped wooden-body modes, normalized to unit energy.
+void MakeBodyImpulse(float *ir, size_t length, float sr);
+
+extern Convolver body_convolver;
+
+// Sets the body wet/dry. The stage only runs while the mix is above 0,
+// and its history is cleared on the way in so stale input is never
+// heard. Real-time safe.
+void SetBodyMix(float mix);
+
+extern bool   body_enabled;   // Follows body_mix > 0
+extern float  body_mix;       // Wet/dry (0 to 1), build-time default
+extern size_t body_ir_length; // Samples, up to MAX_IR_LENGTH
@@ -25,7 +25,206 @@
 //
 // See http://creativecommons.org/licenses/MIT/ for more information.
 // ----------------------------------------------------------------------------
+#include "daisy_seed.h"
 #include "env.h"
+#include "budget.h"
 
-daisysp::Adsr osc1_env;
-daisysp::Adsr osc2_env;
\ No newline at end of file
+#include <cmath>
+
+Envelope DTCM_MEM_SECTION osc1_env;
+Envelope DTCM_MEM_SECTION osc2_env;
+
+static_assert(sizeof(osc1_env) + sizeof(osc2_env)
+                  <= BUDGET_DTCM_VOICE_STATE / 4,
+              "envelopes over budget");
+
+Envelope::Envelope()
+{
+    Init(48000.f);
+}
+
+void Envelope::Init(float sr)
+{
+    samplerate_ = sr;
+    attack_     = 0.01f;
+    decay_      = 0.1f;
+    release_    = 0.5f;
+    sustain_    = 0.7f;
+    shape_      = 0.5f;
+    gate_       = false;
+    segment_    = ENV_SEG_IDLE;
+    value_      = 0.f;
+    target_     = 0.f;
+    mult_       = 1.f;
+    add_        = 0.f;
+    remaining_  = 0;
+}
+
+void Envelope::SetTime(int segment, float seconds)
+{
+    seconds = fmaxf(seconds, 0.f);
+    switch(segment)
+    {
+        case ENV_SEG_ATTACK: attack_ = seconds; break;
+        case ENV_SEG_DECAY: decay_ = seconds; break;
+        case ENV_SEG_RELEASE: release_ = seconds; break;
+        default: break;
+    }
+}
+
+void Envelope::SetSustainLevel(float level)
+{
+    sustain_ = fmaxf(0.f, fminf(level, 1.f));
+}
+
+void Envelope::SetShape(float shape)
+{
+    shape = fmaxf(0.f, fminf(shape, 1.f));
+    if(shape == shape_)
+        return;
+    shape_ = shape;
+
+    // Re-aim the segment in progress from the current value, still
+    // landing on its target after the remaining samples.
+    if(segment_ != ENV_SEG_IDLE && segment_ != ENV_SEG_SUSTAIN
+       && remaining_ > 1)
+        UpdateCoefficients();
+}
+
+void Envelope::ProcessBlock(float *out, size_t size, bool gate)
+{
+    if(gate != gate_)
+    {
+        gate_ = gate;
+        EnterSegment(gate ? ENV_SEG_ATTACK : ENV_SEG_RELEASE);
+    }
+
+    size_t n = 0;
+    while(n < size)
+    {
+        if(segment_ == ENV_SEG_IDLE || segment_ == ENV_SEG_SUSTAIN)
+        {
+            if(segment_ == ENV_SEG_SUSTAIN)
+                value_ = sustain_;
+            for(; n < size; n++)
+                out[n] = value_;
+            break;
+        }
+
+        // Run the recursion up to the end of the segment or block
+        size_t run = size - n < remaining_ ? size - n : remaining_;
+        float  v   = value_;
+        for(size_t i = 0; i < run; i++)
+        {
+            v          = v * mult_ + add_;
+            out[n + i] = v;
+        }
+        value_ = v;
+        n += run;
+        remaining_ -= run;
+
+        if(remaining_ == 0)
+        {
+            // Land exactly on the segment target
+            value_     = target_;
+            out[n - 1] = target_;
+            switch(segment_)
+            {
+                case ENV_SEG_ATTACK: EnterSegment(ENV_SEG_DECAY); break;
+                case ENV_SEG_DECAY: EnterSegment(ENV_SEG_SUSTAIN); break;
+                default: EnterSegment(ENV_SEG_IDLE); break;
+            }
+        }
+    }
+}
+
+void Envelope::GetState(EnvelopeState &state) const
+{
+    state.segment   = segment_;
+    state.gate      = gate_;
+    state.value     = value_;
+    state.target    = target_;
+    state.mult      = mult_;
+    state.add       = add_;
+    state.remaining = remaining_;
+}
+
+void Envelope::SetState(const EnvelopeState &state)
+{
+    segment_ = (state.segment >= ENV_SEG_IDLE && state.segment <= ENV_SEG_RELEASE)
+                   ? state.segment
+                   : ENV_SEG_IDLE;
+    gate_      = state.gate != 0;
+    value_     = state.value;
+    target_    = state.target;
+    mult_      = state.mult;
+    add_       = state.add;
+    remaining_ = state.remaining;
+
+    // A timed segment always has at least the sample that lands it
+    if(segment_ != ENV_SEG_IDLE && segment_ != ENV_SEG_SUSTAIN
+       && remaining_ == 0)
+        remaining_ = 1;
+}
+
+void Envelope::EnterSegment(int segment)
+{
+    segment_ = segment;
+
+    float seconds;
+    switch(segment)
+    {
+        case ENV_SEG_ATTACK:
+            seconds = attack_;
+            target_ = 1.f;
+            break;
+        case ENV_SEG_DECAY:
+            seconds = decay_;
+            target_ = sustain_;
+            break;
+        case ENV_SEG_RELEASE:
+            seconds = release_;
+            target_ = 0.f;
+            break;
+        default: remaining_ = 0; return;
+    }
+
+    remaining_ = static_cast<size_t>(seconds * samplerate_);
+    if(remaining_ == 0 || target_ == value_)
+    {
+        // Zero-length segment: jump to the target on the next sample
+        remaining_ = 1;
+        mult_      = 0.f;
+        add_       = target_;
+        return;
+    }
+    UpdateCoefficients();
+}
+
+// Aims the recursion from value_ to target_ over remaining_ samples
+void Envelope::UpdateCoefficients()
+{
+    float span = target_ - value_;
+    if(span == 0.f)
+    {
+        mult_ = 0.f;
+        add_  = target_;
+        return;
+    }
+
+    float samples = static_cast<float>(remaining_);
+    if(shape_ <= 0.f)
+    {
+        mult_ = 1.f;
+        add_  = span / samples;
+        return;
+    }
+
+    // Overshoot ratio: ~linear at 100x the span, exponential at 0.001x.
+    // The segment reaches target_ exactly after `samples` steps.
+    float ratio     = powf(10.f, 2.f - 5.f * shape_);
+    float overshoot = target_ + ratio * span;
+    float k         = logf((1.f + ratio) / ratio) / samples;
+    mult_           = expf(-k);
+    add_            = overshoot * -expm1f(-k);
+}
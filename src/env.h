@@ -25,13 +25,71 @@
 //
 // See http://creativecommons.org/licenses/MIT/ for more information.
 // ----------------------------------------------------------------------------
-#include "daisysp.h"
+#pragma once
 
-using namespace daisysp;
+#include <cstddef>
+#include <cstdint>
 
-// ADSR envelopes
-extern daisysp::Adsr osc1_env;
-extern daisysp::Adsr osc2_env;
+enum EnvelopeSegment
+{
+    ENV_SEG_IDLE,
+    ENV_SEG_ATTACK,
+    ENV_SEG_DECAY,
+    ENV_SEG_SUSTAIN,
+    ENV_SEG_RELEASE,
+};
+
+// Complete envelope state, for snapshots
+struct EnvelopeState
+{
+    int32_t segment;
+    int32_t gate;
+    float value;
+    float target;
+    float mult, add;
+    uint32_t remaining;
+};
+
+// -------------------------------------------------
+// Envelope
+// -------------------------------------------------
+// ADSR rendered a block at a time. Every timed segment is a one-pole
+// recursion y = y * mult + add towards an overshoot target; the shape
+// parameter sets how far the target overshoots, morphing each segment
+// from linear (0) to strongly exponential (1). Coefficients are
+// recomputed when a segment starts, and when the shape changes mid-way
+// so the segment in progress bends from where it is.
+class Envelope
+{
+  public:
+    Envelope();
+    void Init(float sr);
+    void SetTime(int segment, float seconds);
+    void SetSustainLevel(float level);
+    void SetShape(float shape);
+    void ProcessBlock(float *out, size_t size, bool gate);
+    int Segment() const { return segment_; }
+    float Value() const { return value_; }
+    void GetState(EnvelopeState &state) const;
+    void SetState(const EnvelopeState &state);
+
+  private:
+    float samplerate_;
+    float attack_, decay_, release_;
+    float sustain_;
+    float shape_;
+    bool gate_;
+    int segment_;
+    float value_;
+    float target_;
+    float mult_, add_;
+    size_t remaining_;
+    void EnterSegment(int segment);
+    void UpdateCoefficients();
+};
+
+extern Envelope osc1_env;
+extern Envelope osc2_env;
 
 extern float osc1_envelope_shape;
-extern float osc2_envelope_shape;
\ No newline at end of file
+extern float osc2_envelope_shape;
@@ -25,7 +25,9 @@
 //
 // See http://creativecommons.org/licenses/MIT/ for more information.
 // ----------------------------------------------------------------------------
+#include "daisy_seed.h"
 #include "filter.h"
+#include "budget.h"
 #include <cmath>
 
 static constexpr float TWO_PI = 6.28318530717959f;
@@ -45,24 +47,7 @@ void BiquadFilter::Reset()
 
 void BiquadFilter::SetBandPass(float sr, float centerFreq, float bandwidth)
 {
-    if(centerFreq < 1.f)
-        centerFreq = 1.f;
-    if(centerFreq > sr * 0.49f)
-        centerFreq = sr * 0.49f;
-    if(bandwidth <= 0.f)
-        bandwidth = 0.01f;
-
-    float omega = TWO_PI * centerFreq / sr;
-    float alpha = sinf(omega)
-        * sinhf(M_LN2 / 2.f * bandwidth * omega / sinf(omega));
-    float cosw = cosf(omega);
-
-    b0_ = alpha;
-    b1_ = 0.f;
-    b2_ = -alpha;
-    a1_ = -2.f * cosw;
-    a2_ = 1.f - alpha;
-    Normalize();
+    BandPassCoeffs(sr, centerFreq, bandwidth, b0_, b1_, b2_, a1_, a2_);
 }
 
 float BiquadFilter::Process(float x)
@@ -73,83 +58,33 @@ float BiquadFilter::Process(float x)
     return y;
 }
 
-void BiquadFilter::Normalize()
-{
-    float norm = 1.f + a1_ + a2_;
-    if(norm > 0.f)
-    {
-        b0_ /= norm;
-        b1_ /= norm;
-        b2_ /= norm;
-        a1_ /= norm;
-        a2_ /= norm;
-    }
-}
-
-// --------------------- FormantFilter ---------------------
-FormantFilter formant_filter;
-float formant_freq      = 500.f;
-float formant_bw        = 100.f;
-float formant_amp       = 1.f;
-float formant_resonance = 1.f;
-
-FormantFilter::FormantFilter(size_t numFormants)
-{
-    if(numFormants < 1)
-        numFormants = 3;
-    filters_.resize(numFormants);
-    freq_.resize(numFormants, 500.f);
-    bw_.resize(numFormants, 100.f);
-    samplerate_ = 48000.f;
-    amp_        = 1.f;
-    resonance_  = 1.f;
-    UpdateFilters();
-}
-
-void FormantFilter::Init(float sr)
-{
-    samplerate_ = sr;
-    UpdateFilters();
-}
-
-void FormantFilter::SetFreq(float f)
+void BiquadFilter::BandPassCoeffs(float sr, float centerFreq, float bandwidth,
+                                  float &b0, float &b1, float &b2,
+                                  float &a1, float &a2)
 {
-    for(size_t i = 0; i < filters_.size(); i++)
-        freq_[i] = f;
-    UpdateFilters();
-}
-
-void FormantFilter::SetBandwidth(float bw)
-{
-    for(size_t i = 0; i < filters_.size(); i++)
-        bw_[i] = bw;
-    UpdateFilters();
-}
-
-void FormantFilter::SetAmp(float a)
-{
-    amp_ = a;
-}
+    if(centerFreq < 1.f)
+        centerFreq = 1.f;
+    if(centerFreq > sr * 0.49f)
+        centerFreq = sr * 0.49f;
+    if(bandwidth <= 0.f)
+        bandwidth = 0.01f;
 
-void FormantFilter::SetResonance(float r)
-{
-    resonance_ = r;
-    UpdateFilters();
+    float omega = TWO_PI * centerFreq / sr;
+    float q     = centerFreq / bandwidth;
+    float alpha = sinf(omega) / (2.f * q);
+    float cosw  = cosf(omega);
+
+    // Normalize by a0 = 1 + alpha
+    float norm = 1.f / (1.f + alpha);
+    b0         = alpha * norm;
+    b1         = 0.f;
+    b2         = -alpha * norm;
+    a1         = -2.f * cosw * norm;
+    a2         = (1.f - alpha) * norm;
 }
 
-float FormantFilter::Process(float x)
-{
-    float y = x;
-    for(size_t i = 0; i < filters_.size(); i++)
-        y = filters_[i].Process(y);
-    return y * amp_;
-}
+// --------------------- FormantBank ---------------------
+FormantBank<FORMANT_LANES> DTCM_MEM_SECTION formant_bank;
 
-void FormantFilter::UpdateFilters()
-{
-    for(size_t i = 0; i < filters_.size(); i++)
-    {
-        float adjustedBW = bw_[i] / resonance_;
-        filters_[i].SetBandPass(samplerate_, freq_[i], adjustedBW);
-    }
-}
+static_assert(sizeof(formant_bank) <= BUDGET_DTCM_VOICE_STATE / 2,
+              "formant bank over budget");
@@ -27,7 +27,8 @@
 // ----------------------------------------------------------------------------
 #pragma once
 
-#include <vector>
+#include <cmath>
+#include <cstddef>
 
 // -------------------------------------------------
 // BiquadFilter
@@ -40,46 +41,183 @@ class BiquadFilter
     void SetBandPass(float sr, float centerFreq, float bandwidth);
     float Process(float x);
 
+    // Normalized band-pass coefficients with 0dB peak gain,
+    // bandwidth in Hz.
+    static void BandPassCoeffs(float sr, float centerFreq, float bandwidth,
+                               float &b0, float &b1, float &b2,
+                               float &a1, float &a2);
+
   private:
     float b0_, b1_, b2_;
     float a1_, a2_;
     float z1_, z2_;
-    void Normalize();
 };
 
 // -------------------------------------------------
-// FormantFilter
+// FormantBank
 // -------------------------------------------------
-class FormantFilter
+// A cascade of band-pass stages for 2, 4 or 8 independent lanes, each
+// brought back to its dry level by a make-up gain and blended with its
+// dry input. Coefficients and state are stored
+// structure-of-arrays as GCC vector types, so each biquad stage advances
+// every lane with one stream of vector operations on SIMD hosts and is
+// lowered to a scalar loop over lanes on the M7.
+template <int LANES>
+struct FormantLanes;
+
+template <>
+struct FormantLanes<2>
+{
+    typedef float type __attribute__((vector_size(2 * sizeof(float))));
+};
+
+template <>
+struct FormantLanes<4>
+{
+    typedef float type __attribute__((vector_size(4 * sizeof(float))));
+};
+
+template <>
+struct FormantLanes<8>
+{
+    typedef float type __attribute__((vector_size(8 * sizeof(float))));
+};
+
+template <int LANES>
+class FormantBank
 {
   public:
-    FormantFilter(size_t numFormants = 3);
-    void Init(float sr);
-    void SetFreq(float f);
-    void SetBandwidth(float bw);
-    void SetAmp(float a);
-    void SetResonance(float r);
-    float Process(float x);
+    static constexpr int NUM_STAGES = 3;
+    typedef typename FormantLanes<LANES>::type Lanes;
+
+    // Ceiling on the make-up gain (+30dB), so a lone partial at the centre
+    // of the narrowest band cannot swamp the output stage
+    static constexpr float MAX_MAKEUP = 31.6f;
+
+    // Make-up gain for the cascade: the inverse of its amplitude gain on
+    // white noise, so a broadband voice leaves at about its dry level.
+    // Three 0dB-peak band-pass stages with -3dB bandwidth B pass about
+    // (3pi/8)(B/2) Hz of the sr/2 band.
+    static float MakeupGain(float sr, float bandwidth)
+    {
+        static_assert(NUM_STAGES == 3, "make-up gain assumes three stages");
+        float passed = 3.f * 3.14159265f * bandwidth / (8.f * sr);
+        float gain   = 1.f / sqrtf(passed);
+        return gain < 1.f ? 1.f : (gain > MAX_MAKEUP ? MAX_MAKEUP : gain);
+    }
+
+    void Init(float sr)
+    {
+        samplerate_ = sr;
+        for(int s = 0; s < NUM_STAGES; s++)
+        {
+            z1_[s] = Lanes{};
+            z2_[s] = Lanes{};
+        }
+        for(int l = 0; l < LANES; l++)
+        {
+            SetLane(l, 500.f, 100.f, 1.f, 1.f);
+            SetMix(l, 1.f);
+        }
+    }
+
+    void SetLane(int lane, float freq, float bw, float resonance, float amp)
+    {
+        float b0, b1, b2, a1, a2;
+        BiquadFilter::BandPassCoeffs(
+            samplerate_, freq, bw / resonance, b0, b1, b2, a1, a2);
+        for(int s = 0; s < NUM_STAGES; s++)
+        {
+            b0_[s][lane] = b0;
+            b1_[s][lane] = b1;
+            b2_[s][lane] = b2;
+            a1_[s][lane] = a1;
+            a2_[s][lane] = a2;
+        }
+        amp_[lane] = amp * MakeupGain(samplerate_, bw / resonance);
+    }
+
+    // Wet/dry (0 to 1). The filters keep running when fully dry, so
+    // fading the mix in never starts from stale state.
+    void SetMix(int lane, float mix)
+    {
+        mix_[lane] = mix < 0.f ? 0.f : (mix > 1.f ? 1.f : mix);
+    }
+
+    void GetState(float z1[NUM_STAGES][LANES], float z2[NUM_STAGES][LANES]) const
+    {
+        for(int s = 0; s < NUM_STAGES; s++)
+            for(int l = 0; l < LANES; l++)
+            {
+                z1[s][l] = z1_[s][l];
+                z2[s][l] = z2_[s][l];
+            }
+    }
+
+    void SetState(const float z1[NUM_STAGES][LANES],
+                  const float z2[NUM_STAGES][LANES])
+    {
+        for(int s = 0; s < NUM_STAGES; s++)
+            for(int l = 0; l < LANES; l++)
+            {
+                z1_[s][l] = z1[s][l];
+                z2_[s][l] = z2[s][l];
+            }
+    }
+
+    // Filters each lane's buffer in place.
+    void Process(float *const lanes[LANES], size_t size)
+    {
+        for(size_t n = 0; n < size; n++)
+        {
+            Lanes x;
+            for(int l = 0; l < LANES; l++)
+                x[l] = lanes[l][n];
+            Lanes dry = x;
+
+            for(int s = 0; s < NUM_STAGES; s++)
+            {
+                Lanes y = b0_[s] * x + z1_[s];
+                z1_[s]  = b1_[s] * x - a1_[s] * y + z2_[s];
+                z2_[s]  = b2_[s] * x - a2_[s] * y;
+                x       = y;
+            }
+
+            x = dry + (x * amp_ - dry) * mix_;
+            for(int l = 0; l < LANES; l++)
+                lanes[l][n] = x[l];
+        }
+    }
 
   private:
     float samplerate_;
-    float amp_;
-    float resonance_;
-    std::vector<BiquadFilter> filters_;
-    std::vector<float> freq_;
-    std::vector<float> bw_;
-    void UpdateFilters();
+    Lanes b0_[NUM_STAGES], b1_[NUM_STAGES], b2_[NUM_STAGES];
+    Lanes a1_[NUM_STAGES], a2_[NUM_STAGES];
+    Lanes z1_[NUM_STAGES], z2_[NUM_STAGES];
+    Lanes amp_;
+    Lanes mix_;
+};
+
+// Voice 1 and voice 2 stereo pairs share one four lane bank
+enum
+{
+    FORMANT_LANE_OSC1_L,
+    FORMANT_LANE_OSC1_R,
+    FORMANT_LANE_OSC2_L,
+    FORMANT_LANE_OSC2_R,
+    FORMANT_LANES,
 };
 
-extern FormantFilter osc1_formant_filter;
-extern FormantFilter osc2_formant_filter;
+extern FormantBank<FORMANT_LANES> formant_bank;
 
 extern float osc1_formant_freq;
 extern float osc1_formant_bw;
 extern float osc1_formant_amp;
 extern float osc1_formant_resonance;
+extern float osc1_formant_mix;
 
 extern float osc2_formant_freq;
 extern float osc2_formant_bw;
 extern float osc2_formant_amp;
 extern float osc2_formant_resonance;
+extern float osc2_formant_mix;
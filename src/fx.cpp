@@ -0,0 +1,409 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#include "daisy_seed.h"
+#include "fx.h"
+#include "budget.h"
+
+#include <cmath>
+#include <cstring>
+
+// Delay line storage lives in SDRAM. The section is NOLOAD, so every line
+// is cleared explicitly in Init().
+static float DSY_SDRAM_BSS delay_buffer_l[StereoDelay::MAX_LINE_SIZE];
+static float DSY_SDRAM_BSS delay_buffer_r[StereoDelay::MAX_LINE_SIZE];
+static float DSY_SDRAM_BSS
+    reverb_buffers[FdnReverb::NUM_LINES][FdnReverb::MAX_LINE_SIZE];
+
+static_assert(sizeof(delay_buffer_l) + sizeof(delay_buffer_r)
+                      + sizeof(reverb_buffers)
+                  <= BUDGET_SDRAM_FX,
+              "delay lines over budget");
+
+// Mutually prime line lengths at 48kHz, scaled by SetSize().
+static const size_t REVERB_BASE_LENGTHS[FdnReverb::NUM_LINES]
+    = {1447, 1721, 2053, 2371};
+
+// Line positions, filter state and scratch stay in DTCM
+SendEffects DTCM_MEM_SECTION fx;
+
+static_assert(sizeof(fx) <= BUDGET_DTCM_FX_STATE, "send effects over budget");
+
+float fx_delay_send     = 0.0f;  // Delay send level (0 to 1)
+float fx_delay_time     = 0.35f; // Delay time (seconds)
+float fx_delay_feedback = 0.4f;  // Delay feedback (0 to 1)
+float fx_reverb_send    = 0.0f;  // Reverb send level (0 to 1)
+float fx_reverb_decay   = 2.5f;  // Reverb T60 (seconds)
+float fx_reverb_damping = 0.4f;  // Reverb high frequency damping (0 to 1)
+
+static inline size_t ClampDelay(float samples, size_t length)
+{
+    if(samples < static_cast<float>(MAX_BLOCK_SIZE))
+        return MAX_BLOCK_SIZE;
+    if(samples > static_cast<float>(length - 1))
+        return length - 1;
+    return static_cast<size_t>(samples);
+}
+
+// --------------------- DelayLine ---------------------
+DelayLine::DelayLine() : buffer_(nullptr), length_(0), write_pos_(0) {}
+
+void DelayLine::Init(float *buffer, size_t length)
+{
+    buffer_    = buffer;
+    length_    = length;
+    write_pos_ = 0;
+    Clear();
+}
+
+void DelayLine::Clear()
+{
+    memset(buffer_, 0, length_ * sizeof(float));
+}
+
+void DelayLine::Read(float *dst, size_t delay, size_t size) const
+{
+    size_t pos   = (write_pos_ + length_ - delay) % length_;
+    size_t first = length_ - pos;
+    if(first >= size)
+    {
+        memcpy(dst, buffer_ + pos, size * sizeof(float));
+    }
+    else
+    {
+        memcpy(dst, buffer_ + pos, first * sizeof(float));
+        memcpy(dst + first, buffer_, (size - first) * sizeof(float));
+    }
+}
+
+void DelayLine::Write(const float *src, size_t size)
+{
+    size_t first = length_ - write_pos_;
+    if(first >= size)
+    {
+        memcpy(buffer_ + write_pos_, src, size * sizeof(float));
+    }
+    else
+    {
+        memcpy(buffer_ + write_pos_, src, first * sizeof(float));
+        memcpy(buffer_, src + first, (size - first) * sizeof(float));
+    }
+    write_pos_ = (write_pos_ + size) % length_;
+}
+
+void DelayLine::GetState(float *contents, uint32_t &write_pos) const
+{
+    memcpy(contents, buffer_, length_ * sizeof(float));
+    write_pos = write_pos_;
+}
+
+void DelayLine::SetState(const float *contents, uint32_t write_pos)
+{
+    memcpy(buffer_, contents, length_ * sizeof(float));
+    write_pos_ = write_pos % length_;
+}
+
+// --------------------- StereoDelay ---------------------
+StereoDelay::StereoDelay()
+{
+    samplerate_ = 48000.f;
+    time_       = 0.35f;
+    spread_     = 0.02f;
+    feedback_   = 0.4f;
+    damp_coef_  = 0.6f;
+    lp_l_ = lp_r_ = 0.f;
+    delay_l_ = delay_r_ = MAX_BLOCK_SIZE;
+}
+
+void StereoDelay::Init(float sr, float *buffer_l, float *buffer_r, size_t length)
+{
+    samplerate_ = sr;
+    line_l_.Init(buffer_l, length);
+    line_r_.Init(buffer_r, length);
+    lp_l_ = lp_r_ = 0.f;
+    UpdateTimes();
+}
+
+void StereoDelay::SetTime(float seconds)
+{
+    time_ = seconds;
+    UpdateTimes();
+}
+
+void StereoDelay::SetSpread(float seconds)
+{
+    spread_ = seconds;
+    UpdateTimes();
+}
+
+void StereoDelay::SetFeedback(float fb)
+{
+    feedback_ = fmaxf(0.f, fminf(fb, 0.98f));
+}
+
+void StereoDelay::SetDamping(float d)
+{
+    d          = fmaxf(0.f, fminf(d, 1.f));
+    damp_coef_ = 1.f - 0.9f * d;
+}
+
+void StereoDelay::Clear()
+{
+    line_l_.Clear();
+    line_r_.Clear();
+    lp_l_ = lp_r_ = 0.f;
+}
+
+void StereoDelay::Process(const float *in_l, const float *in_r,
+                          float *out_l, float *out_r, size_t size)
+{
+    for(size_t offset = 0; offset < size; offset += MAX_BLOCK_SIZE)
+    {
+        size_t n = NextChunk(size - offset);
+        line_l_.Read(tap_l_, delay_l_, n);
+        line_r_.Read(tap_r_, delay_r_, n);
+        for(size_t i = 0; i < n; i++)
+        {
+            lp_l_ += (tap_l_[i] - lp_l_) * damp_coef_;
+            lp_r_ += (tap_r_[i] - lp_r_) * damp_coef_;
+            out_l[offset + i] += tap_l_[i];
+            out_r[offset + i] += tap_r_[i];
+            tap_l_[i] = in_l[offset + i] + lp_l_ * feedback_;
+            tap_r_[i] = in_r[offset + i] + lp_r_ * feedback_;
+        }
+        line_l_.Write(tap_l_, n);
+        line_r_.Write(tap_r_, n);
+    }
+}
+
+void StereoDelay::GetState(StereoDelayState &state, float *lines) const
+{
+    state.lp_l = lp_l_;
+    state.lp_r = lp_r_;
+    line_l_.GetState(lines, state.pos_l);
+    line_r_.GetState(lines + MAX_LINE_SIZE, state.pos_r);
+}
+
+void StereoDelay::SetState(const StereoDelayState &state, const float *lines)
+{
+    lp_l_ = state.lp_l;
+    lp_r_ = state.lp_r;
+    line_l_.SetState(lines, state.pos_l);
+    line_r_.SetState(lines + MAX_LINE_SIZE, state.pos_r);
+}
+
+void StereoDelay::UpdateTimes()
+{
+    if(line_l_.Length() == 0)
+        return;
+    delay_l_ = ClampDelay(time_ * samplerate_, line_l_.Length());
+    delay_r_ = ClampDelay((time_ + spread_) * samplerate_, line_r_.Length());
+}
+
+// --------------------- FdnReverb ---------------------
+FdnReverb::FdnReverb()
+{
+    samplerate_ = 48000.f;
+    size_      = 1.f;
+    decay_     = 2.5f;
+    damp_coef_ = 0.6f;
+    for(int i = 0; i < NUM_LINES; i++)
+    {
+        length_[i] = REVERB_BASE_LENGTHS[i];
+        gain_[i]   = 0.f;
+        lp_[i]     = 0.f;
+    }
+}
+
+void FdnReverb::Init(float sr, float *buffers[NUM_LINES])
+{
+    samplerate_ = sr;
+    for(int i = 0; i < NUM_LINES; i++)
+    {
+        lines_[i].Init(buffers[i], MAX_LINE_SIZE);
+        lp_[i] = 0.f;
+    }
+    UpdateLines();
+}
+
+void FdnReverb::SetSize(float s)
+{
+    size_ = fmaxf(0.25f, fminf(s, 2.f));
+    UpdateLines();
+}
+
+void FdnReverb::SetDecay(float seconds)
+{
+    decay_ = fmaxf(0.1f, seconds);
+    UpdateLines();
+}
+
+void FdnReverb::SetDamping(float d)
+{
+    d          = fmaxf(0.f, fminf(d, 1.f));
+    damp_coef_ = 1.f - 0.9f * d;
+}
+
+void FdnReverb::Clear()
+{
+    for(int i = 0; i < NUM_LINES; i++)
+    {
+        lines_[i].Clear();
+        lp_[i] = 0.f;
+    }
+}
+
+void FdnReverb::Process(const float *in_l, const float *in_r,
+                        float *out_l, float *out_r, size_t size)
+{
+    for(size_t offset = 0; offset < size; offset += MAX_BLOCK_SIZE)
+    {
+        size_t n = NextChunk(size - offset);
+
+        // Every line is longer than a block, so the whole block of
+        // feedback can be fetched up front and written back afterwards.
+        for(int l = 0; l < NUM_LINES; l++)
+            lines_[l].Read(tap_[l], length_[l], n);
+
+        for(size_t i = 0; i < n; i++)
+        {
+            float in = (in_l[offset + i] + in_r[offset + i]) * 0.5f;
+
+            out_l[offset + i] += (tap_[0][i] + tap_[2][i]) * 0.5f;
+            out_r[offset + i] += (tap_[1][i] + tap_[3][i]) * 0.5f;
+
+            float x[NUM_LINES];
+            for(int l = 0; l < NUM_LINES; l++)
+            {
+                lp_[l] += (tap_[l][i] - lp_[l]) * damp_coef_;
+                x[l] = lp_[l] * gain_[l];
+            }
+
+            // 4x4 Hadamard, scaled to stay unitary
+            tap_[0][i] = in + 0.5f * (x[0] + x[1] + x[2] + x[3]);
+            tap_[1][i] = in + 0.5f * (x[0] - x[1] + x[2] - x[3]);
+            tap_[2][i] = in + 0.5f * (x[0] + x[1] - x[2] - x[3]);
+            tap_[3][i] = in + 0.5f * (x[0] - x[1] - x[2] + x[3]);
+        }
+
+        for(int l = 0; l < NUM_LINES; l++)
+            lines_[l].Write(tap_[l], n);
+    }
+}
+
+void FdnReverb::GetState(FdnReverbState &state, float *lines) const
+{
+    for(int i = 0; i < NUM_LINES; i++)
+    {
+        state.lp[i] = lp_[i];
+        lines_[i].GetState(lines + i * MAX_LINE_SIZE, state.pos[i]);
+    }
+}
+
+void FdnReverb::SetState(const FdnReverbState &state, const float *lines)
+{
+    for(int i = 0; i < NUM_LINES; i++)
+    {
+        lp_[i] = state.lp[i];
+        lines_[i].SetState(lines + i * MAX_LINE_SIZE, state.pos[i]);
+    }
+}
+
+void FdnReverb::UpdateLines()
+{
+    float scale = size_ * samplerate_ / 48000.f;
+    for(int i = 0; i < NUM_LINES; i++)
+    {
+        length_[i] = ClampDelay(REVERB_BASE_LENGTHS[i] * scale, MAX_LINE_SIZE);
+        // Per-line gain for a -60dB decay after decay_ seconds
+        gain_[i] = powf(10.f, -3.f * length_[i] / (decay_ * samplerate_));
+    }
+}
+
+// --------------------- SendEffects ---------------------
+void SendEffects::Init(float sr)
+{
+    delay_send_  = 0.f;
+    reverb_send_ = 0.f;
+
+    delay_.Init(sr, delay_buffer_l, delay_buffer_r, StereoDelay::MAX_LINE_SIZE);
+
+    float *lines[FdnReverb::NUM_LINES];
+    for(int i = 0; i < FdnReverb::NUM_LINES; i++)
+        lines[i] = reverb_buffers[i];
+    reverb_.Init(sr, lines);
+}
+
+void SendEffects::Clear()
+{
+    delay_.Clear();
+    reverb_.Clear();
+}
+
+void SendEffects::Process(float *left, float *right, size_t size)
+{
+    for(size_t offset = 0; offset < size; offset += MAX_BLOCK_SIZE)
+    {
+        size_t n = NextChunk(size - offset);
+        float *l = left + offset;
+        float *r = right + offset;
+
+        for(size_t i = 0; i < n; i++)
+        {
+            send_l_[i] = l[i] * delay_send_;
+            send_r_[i] = r[i] * delay_send_;
+            wet_l_[i]  = 0.f;
+            wet_r_[i]  = 0.f;
+        }
+        delay_.Process(send_l_, send_r_, wet_l_, wet_r_, n);
+
+        for(size_t i = 0; i < n; i++)
+        {
+            send_l_[i] = l[i] * reverb_send_;
+            send_r_[i] = r[i] * reverb_send_;
+        }
+        reverb_.Process(send_l_, send_r_, wet_l_, wet_r_, n);
+
+        for(size_t i = 0; i < n; i++)
+        {
+            l[i] += wet_l_[i];
+            r[i] += wet_r_[i];
+        }
+    }
+}
+
+void SendEffects::GetState(SendEffectsState &state, float *lines) const
+{
+    delay_.GetState(state.delay, lines);
+    reverb_.GetState(state.reverb, lines + 2 * StereoDelay::MAX_LINE_SIZE);
+}
+
+void SendEffects::SetState(const SendEffectsState &state, const float *lines)
+{
+    delay_.SetState(state.delay, lines);
+    reverb_.SetState(state.reverb, lines + 2 * StereoDelay::MAX_LINE_SIZE);
+}
@@ -0,0 +1,200 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include "block.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// -------------------------------------------------
+// DelayLine
+// -------------------------------------------------
+// Circular buffer intended to live in SDRAM. It is only ever touched in
+// contiguous block-sized chunks (at most two bursts per access when the
+// chunk wraps), so the external memory latency is paid per block rather
+// than per sample.
+class DelayLine
+{
+  public:
+    DelayLine();
+    void Init(float *buffer, size_t length);
+    void Clear();
+    // Copy `size` samples that were written `delay` samples before the
+    // current write position. `delay` must be >= `size`.
+    void Read(float *dst, size_t delay, size_t size) const;
+    void Write(const float *src, size_t size);
+    size_t Length() const { return length_; }
+    // Copies the Length() samples of the line and its write position.
+    void GetState(float *contents, uint32_t &write_pos) const;
+    void SetState(const float *contents, uint32_t write_pos);
+
+  private:
+    float *buffer_;
+    size_t length_;
+    size_t write_pos_;
+};
+
+// Filter state and line positions; the line contents travel separately
+// because they are several megabytes.
+struct StereoDelayState
+{
+    float lp_l, lp_r;
+    uint32_t pos_l, pos_r;
+};
+
+struct FdnReverbState
+{
+    float lp[4];
+    uint32_t pos[4];
+};
+
+struct SendEffectsState
+{
+    StereoDelayState delay;
+    FdnReverbState reverb;
+};
+
+// -------------------------------------------------
+// StereoDelay
+// -------------------------------------------------
+class StereoDelay
+{
+  public:
+    static constexpr size_t MAX_LINE_SIZE = 2 * 96000; // 2s at 96kHz
+
+    StereoDelay();
+    void Init(float sr, float *buffer_l, float *buffer_r, size_t length);
+    void SetTime(float seconds);
+    void SetSpread(float seconds);
+    void SetFeedback(float fb);
+    void SetDamping(float d);
+    void Clear();
+    // Adds the wet signal for `in_l`/`in_r` into `out_l`/`out_r`.
+    void Process(const float *in_l, const float *in_r,
+                 float *out_l, float *out_r, size_t size);
+    // `lines` holds 2 * MAX_LINE_SIZE samples, left then right.
+    void GetState(StereoDelayState &state, float *lines) const;
+    void SetState(const StereoDelayState &state, const float *lines);
+
+  private:
+    float samplerate_;
+    size_t delay_l_, delay_r_;
+    float time_, spread_;
+    float feedback_;
+    float damp_coef_;
+    float lp_l_, lp_r_;
+    DelayLine line_l_, line_r_;
+    float tap_l_[MAX_BLOCK_SIZE];
+    float tap_r_[MAX_BLOCK_SIZE];
+    void UpdateTimes();
+};
+
+// -------------------------------------------------
+// FdnReverb
+// -------------------------------------------------
+// Four line feedback delay network with a Hadamard mixing matrix and a
+// one-pole damping filter per line.
+class FdnReverb
+{
+  public:
+    static constexpr int    NUM_LINES     = 4;
+    static constexpr size_t MAX_LINE_SIZE = 16384;
+
+    FdnReverb();
+    void Init(float sr, float *buffers[NUM_LINES]);
+    void SetSize(float s);
+    void SetDecay(float seconds);
+    void SetDamping(float d);
+    void Clear();
+    // Adds the wet signal for `in_l`/`in_r` into `out_l`/`out_r`.
+    void Process(const float *in_l, const float *in_r,
+                 float *out_l, float *out_r, size_t size);
+    // `lines` holds NUM_LINES * MAX_LINE_SIZE samples.
+    void GetState(FdnReverbState &state, float *lines) const;
+    void SetState(const FdnReverbState &state, const float *lines);
+
+  private:
+    float samplerate_;
+    float size_;
+    float decay_;
+    float damp_coef_;
+    size_t length_[NUM_LINES];
+    float gain_[NUM_LINES];
+    float lp_[NUM_LINES];
+    DelayLine lines_[NUM_LINES];
+    float tap_[NUM_LINES][MAX_BLOCK_SIZE];
+    void UpdateLines();
+};
+
+static_assert(FdnReverb::NUM_LINES == 4, "FdnReverbState holds four lines");
+
+// -------------------------------------------------
+// SendEffects
+// -------------------------------------------------
+class SendEffects
+{
+  public:
+    // Samples of delay line storage behind GetState()/SetState()
+    static constexpr size_t LINE_SAMPLES
+        = 2 * StereoDelay::MAX_LINE_SIZE
+          + FdnReverb::NUM_LINES * FdnReverb::MAX_LINE_SIZE;
+
+    void Init(float sr);
+    void SetDelaySend(float s) { delay_send_ = s; }
+    void SetReverbSend(float s) { reverb_send_ = s; }
+    StereoDelay &Delay() { return delay_; }
+    FdnReverb &Reverb() { return reverb_; }
+    // Silences both delay networks. Touches all of SDRAM used by the
+    // lines, so never call from the audio callback.
+    void Clear();
+    // Processes the dry signal in place, adding both returns.
+    void Process(float *left, float *right, size_t size);
+    // Copies every line, LINE_SAMPLES in all. Not real-time safe.
+    void GetState(SendEffectsState &state, float *lines) const;
+    void SetState(const SendEffectsState &state, const float *lines);
+
+  private:
+    float delay_send_;
+    float reverb_send_;
+    StereoDelay delay_;
+    FdnReverb reverb_;
+    float send_l_[MAX_BLOCK_SIZE];
+    float send_r_[MAX_BLOCK_SIZE];
+    float wet_l_[MAX_BLOCK_SIZE];
+    float wet_r_[MAX_BLOCK_SIZE];
+};
+
+extern SendEffects fx;
+
+extern float fx_delay_send;
+extern float fx_delay_time;
+extern float fx_delay_feedback;
+extern float fx_reverb_send;
+extern float fx_reverb_decay;
+extern float fx_reverb_damping;
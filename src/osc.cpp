@@ -25,16 +25,29 @@
 //
 // See http://creativecommons.org/licenses/MIT/ for more information.
 // ----------------------------------------------------------------------------
-#include "daisysp.h"
+#include "daisy_seed.h"
 #include "osc.h"
 #include "env.h"
+#include "tuning.h"
+#include "budget.h"
+#include "block.h"
 #include <cmath>
 
-daisysp::Oscillator osc1_sine[TOTAL_OSCS];
-daisysp::Oscillator osc1_saw[TOTAL_OSCS];
+static constexpr float TWO_PI = 6.28318530717959f;
 
-daisysp::Oscillator osc2_sine[TOTAL_OSCS];
-daisysp::Oscillator osc2_square[TOTAL_OSCS];
+PhaseOscillator DTCM_MEM_SECTION osc1_sine[TOTAL_OSCS];
+PhaseOscillator DTCM_MEM_SECTION osc1_saw[TOTAL_OSCS];
+
+PhaseOscillator DTCM_MEM_SECTION osc2_sine[TOTAL_OSCS];
+PhaseOscillator DTCM_MEM_SECTION osc2_square[TOTAL_OSCS];
+
+// Second waveform of a partial, rendered before the crossfade
+static float DTCM_MEM_SECTION partial_scratch[MAX_BLOCK_SIZE];
+
+static_assert(sizeof(osc1_sine) + sizeof(osc1_saw) + sizeof(osc2_sine)
+                      + sizeof(osc2_square) + sizeof(partial_scratch)
+                  <= BUDGET_DTCM_OSCILLATORS,
+              "oscillators over budget");
 
 float osc1_root_freq = 440.0f;    // root frequency
 float osc1_morph     = 0.0f;      // 0 = sine, 1 = saw
@@ -44,38 +57,149 @@ float osc2_root_freq = 440.0f;    // root freq
 float osc2_morph     = 0.0f;      // 0 = sine, 1 = saw
 float osc2_volume    = 0.8f;      // 0 - 1
 
-void InitOscillator(daisysp::Oscillator &osc, float samplerate, uint8_t wave)
+float osc2_fm_index  = 0.0f;      // phase offset (cycles) per unit of voice 1
+float osc2_ring_mix  = 0.0f;      // 0 = dry, 1 = fully ring modulated
+
+// --------------------- PhaseOscillator ---------------------
+struct SineWave
+{
+    static float Get(float phase) { return sinf(TWO_PI * phase); }
+};
+
+struct SawWave
+{
+    static float Get(float phase) { return 1.f - 2.f * phase; }
+};
+
+struct SquareWave
+{
+    static float Get(float phase) { return phase < 0.5f ? 1.f : -1.f; }
+};
+
+PhaseOscillator::PhaseOscillator()
+{
+    Init(48000.f);
+}
+
+void PhaseOscillator::Init(float sr)
+{
+    sr_recip_  = 1.f / sr;
+    amp_       = 0.5f;
+    phase_     = 0.f;
+    phase_inc_ = 0.f;
+    waveform_  = WAVE_SIN;
+}
+
+void PhaseOscillator::Process(float *out, size_t size, const float *phase_mod)
+{
+    switch(waveform_)
+    {
+        case WAVE_SAW: Render<SawWave>(out, size, phase_mod); break;
+        case WAVE_SQUARE: Render<SquareWave>(out, size, phase_mod); break;
+        default: Render<SineWave>(out, size, phase_mod); break;
+    }
+}
+
+template <typename Wave>
+void PhaseOscillator::Render(float *out, size_t size, const float *phase_mod)
+{
+    float ph = phase_;
+    if(phase_mod)
+    {
+        for(size_t n = 0; n < size; n++)
+        {
+            float p = ph + phase_mod[n];
+            p -= floorf(p);
+            out[n] = amp_ * Wave::Get(p);
+            ph += phase_inc_;
+            if(ph >= 1.f)
+                ph -= 1.f;
+        }
+    }
+    else
+    {
+        for(size_t n = 0; n < size; n++)
+        {
+            out[n] = amp_ * Wave::Get(ph);
+            ph += phase_inc_;
+            if(ph >= 1.f)
+                ph -= 1.f;
+        }
+    }
+    phase_ = ph;
+}
+
+// --------------------- Voices ---------------------
+
+// xorshift32, returns a phase in [0, 1)
+static float NextPhase(uint32_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return (state >> 8) * (1.f / 16777216.f);
+}
+
+void InitOscillator(PhaseOscillator &osc,
+                    float            samplerate,
+                    uint8_t          wave,
+                    float            phase)
 {
     osc.Init(samplerate);
     osc.SetAmp(0.5f);
     osc.SetWaveform(wave);
-    float random_phase = static_cast<float>(rand()) / RAND_MAX;
-    osc.PhaseAdd(random_phase * 2.0f * M_PI);
+    osc.SetPhase(phase);
+}
+
+void InitOscillatorArrays(float sr, uint32_t seed)
+{
+    uint32_t state = (seed != 0) ? seed : DEFAULT_PHASE_SEED;
+    for(int i = 0; i < TOTAL_OSCS; i++)
+    {
+        InitOscillator(osc1_sine[i], sr, PhaseOscillator::WAVE_SIN, NextPhase(state));
+        InitOscillator(osc1_saw[i],  sr, PhaseOscillator::WAVE_SAW, NextPhase(state));
+        InitOscillator(osc2_sine[i], sr, PhaseOscillator::WAVE_SIN, NextPhase(state));
+        InitOscillator(osc2_square[i],  sr, PhaseOscillator::WAVE_SQUARE, NextPhase(state));
+    }
+
+    // Init clears the increments; keep whatever pitch the tunings hold
+    UpdateOsc1Frequencies();
+    UpdateOsc2Frequencies();
+}
+
+void RenderPartial(PhaseOscillator &a,
+                   PhaseOscillator &b,
+                   float            morph,
+                   float            weight,
+                   const float     *phase_mod,
+                   float           *out,
+                   size_t           size)
+{
+    a.Process(out, size, phase_mod);
+    b.Process(partial_scratch, size, phase_mod);
+
+    float wa = (1.f - morph) * weight;
+    float wb = morph * weight;
+    for(size_t n = 0; n < size; n++)
+        out[n] = out[n] * wa + partial_scratch[n] * wb;
 }
 
-void InitOscillatorArrays(float sr)
+void UpdateOsc1Frequencies()
 {
-    using namespace daisysp;
+    const float *incs = osc1_tuning.PartialIncrements();
     for(int i = 0; i < TOTAL_OSCS; i++)
     {
-        InitOscillator(osc1_sine[i], sr, Oscillator::WAVE_SIN);
-        InitOscillator(osc1_saw[i],  sr, Oscillator::WAVE_SAW);
-        InitOscillator(osc2_sine[i], sr, Oscillator::WAVE_SIN);
-        InitOscillator(osc2_square[i],  sr, Oscillator::WAVE_SQUARE);
+        osc1_sine[i].SetPhaseIncrement(incs[i]);
+        osc1_saw[i].SetPhaseIncrement(incs[i]);
     }
 }
 
-void UpdateOscillatorFrequencies()
+void UpdateOsc2Frequencies()
 {
+    const float *incs = osc2_tuning.PartialIncrements();
     for(int i = 0; i < TOTAL_OSCS; i++)
     {
-        // osc1
-        float osc1_freq = (i == 0) ? osc1_root_freq : (osc1_root_freq / (i + 1));
-        osc1_sine[i].SetFreq(osc1_freq);
-        osc1_saw[i].SetFreq(osc1_freq);
-        // osc2
-        float osc2_freq = (i == 0) ? osc1_root_freq : (osc1_root_freq / (i + 1));
-        osc2_sine[i].SetFreq(osc2_freq);
-        osc2_square[i].SetFreq(osc2_freq);
+        osc2_sine[i].SetPhaseIncrement(incs[i]);
+        osc2_square[i].SetPhaseIncrement(incs[i]);
     }
 }
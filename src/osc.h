@@ -27,16 +27,55 @@
 // ----------------------------------------------------------------------------
 #pragma once
 
-#include "daisysp.h"
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
 
 static constexpr int NUM_SUBS   = 4;
 static constexpr int TOTAL_OSCS = 1 + NUM_SUBS;
 
-extern daisysp::Oscillator osc1_sine[TOTAL_OSCS];
-extern daisysp::Oscillator osc1_saw[TOTAL_OSCS];
+// -------------------------------------------------
+// PhaseOscillator
+// -------------------------------------------------
+// Naive sine/saw/square oscillator rendered a block at a time. The
+// optional phase_mod input is a per-sample phase offset in cycles, which
+// gives audio-rate phase modulation for the cost of an add and a wrap.
+class PhaseOscillator
+{
+  public:
+    enum
+    {
+        WAVE_SIN,
+        WAVE_SAW,
+        WAVE_SQUARE,
+    };
 
-extern daisysp::Oscillator osc2_sine[TOTAL_OSCS];
-extern daisysp::Oscillator osc2_square[TOTAL_OSCS];
+    PhaseOscillator();
+    void Init(float sr);
+    void SetWaveform(uint8_t wave) { waveform_ = wave; }
+    void SetAmp(float amp) { amp_ = amp; }
+    void SetFreq(float freq) { phase_inc_ = freq * sr_recip_; }
+    // Cycles per sample, e.g. straight from a Tuning table
+    void SetPhaseIncrement(float inc) { phase_inc_ = inc; }
+    void SetPhase(float phase) { phase_ = phase - floorf(phase); }
+    float Phase() const { return phase_; }
+    void Process(float *out, size_t size, const float *phase_mod = nullptr);
+
+  private:
+    float sr_recip_;
+    float amp_;
+    float phase_;
+    float phase_inc_;
+    uint8_t waveform_;
+    template <typename Wave>
+    void Render(float *out, size_t size, const float *phase_mod);
+};
+
+extern PhaseOscillator osc1_sine[TOTAL_OSCS];
+extern PhaseOscillator osc1_saw[TOTAL_OSCS];
+
+extern PhaseOscillator osc2_sine[TOTAL_OSCS];
+extern PhaseOscillator osc2_square[TOTAL_OSCS];
 
 extern float osc1_root_freq;  // default freq
 extern float osc1_morph;      // crossfade 0..1
@@ -46,6 +85,32 @@ extern float osc2_root_freq;  // default freq
 extern float osc2_morph;      // crossfade 0..1
 extern float osc2_volume;     // overall volume
 
-void InitOscillatorArrays(float sr);
+extern float osc2_fm_index;   // voice 1 -> voice 2 phase modulation (cycles)
+extern float osc2_ring_mix;   // voice 1 x voice 2 ring modulation 0..1
+
+// Oscillator start phases come from a seeded generator, so the same seed
+// always renders the same output. Safe to call again to reseed: the
+// tunings' current increments are pushed back afterwards.
+static constexpr uint32_t DEFAULT_PHASE_SEED = 0x2545f491;
+
+void InitOscillatorArrays(float sr, uint32_t seed = DEFAULT_PHASE_SEED);
+
+// Push the precomputed root/subharmonic phase increments from each
+// voice's Tuning to its oscillators. Called when the quantized pitch changes.
+void UpdateOsc1Frequencies();
+void UpdateOsc2Frequencies();
+
+void InitOscillator(PhaseOscillator &osc,
+                    float            samplerate,
+                    uint8_t          wave,
+                    float            phase);
 
-void InitOscillator(daisysp::Oscillator &osc, float samplerate, uint8_t wave);
+// Renders one partial as a morph crossfade of two oscillators, scaled by
+// `weight`. Both oscillators receive the same phase modulation.
+void RenderPartial(PhaseOscillator &a,
+                   PhaseOscillator &b,
+                   float            morph,
+                   float            weight,
+                   const float     *phase_mod,
+                   float           *out,
+                   size_t           size);
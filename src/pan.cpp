@@ -0,0 +1,175 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#include "daisy_seed.h"
+#include "pan.h"
+#include "budget.h"
+
+#include <cmath>
+
+StereoSpread DTCM_MEM_SECTION osc1_spread;
+StereoSpread DTCM_MEM_SECTION osc2_spread;
+
+static_assert(sizeof(osc1_spread) + sizeof(osc2_spread)
+                  <= BUDGET_DTCM_VOICE_STATE / 4,
+              "stereo spreaders over budget");
+
+// Build-time settings, applied once by InitAudio(). No panel control is
+// free for them; SetLaw() and SetWidth() are real-time safe for a future
+// one.
+float  osc1_pan        = -0.3f;
+float  osc2_pan        = 0.3f;
+float  stereo_width    = 0.6f;
+float  pan_drift_depth = 0.2f;
+float  pan_drift_rate  = 0.05f;
+PanLaw pan_law         = PAN_EQUAL_POWER;
+
+// Partial offsets from the voice center: the root stays put and the
+// subharmonics fan out alternately left and right.
+static const float SPREAD_OFFSETS[TOTAL_OSCS] = {0.f, -0.5f, 0.5f, -1.f, 1.f};
+
+static constexpr float HALF_PI = 1.57079632679490f;
+
+StereoSpread::StereoSpread()
+{
+    center_      = 0.f;
+    width_       = 0.f;
+    drift_depth_ = 0.f;
+    law_         = PAN_EQUAL_POWER;
+    Init(48000.f);
+}
+
+void StereoSpread::Init(float sr)
+{
+    samplerate_ = sr;
+    drift_inc_  = 0.f;
+    for(int i = 0; i < TOTAL_OSCS; i++)
+    {
+        // Stagger the drift so the partials never move together
+        drift_phase_[i] = static_cast<float>(i) / TOTAL_OSCS;
+    }
+    TargetGains(gain_, 0);
+}
+
+void StereoSpread::SetCenter(float pan)
+{
+    center_ = fmaxf(-1.f, fminf(pan, 1.f));
+}
+
+void StereoSpread::SetWidth(float width)
+{
+    width_ = fmaxf(0.f, fminf(width, 1.f));
+}
+
+void StereoSpread::SetDrift(float depth, float rate_hz)
+{
+    drift_depth_ = fmaxf(0.f, fminf(depth, 1.f));
+    drift_inc_   = fmaxf(rate_hz, 0.f) / samplerate_;
+}
+
+void StereoSpread::SetLaw(PanLaw law)
+{
+    law_ = law;
+}
+
+void StereoSpread::Process(const float partials[TOTAL_OSCS][MAX_BLOCK_SIZE],
+                           float *left, float *right, size_t size)
+{
+    float target[TOTAL_OSCS][2];
+    TargetGains(target, size);
+
+    for(size_t n = 0; n < size; n++)
+    {
+        left[n]  = 0.f;
+        right[n] = 0.f;
+    }
+
+    float inv = 1.f / static_cast<float>(size);
+    for(int i = 0; i < TOTAL_OSCS; i++)
+    {
+        float gl  = gain_[i][0];
+        float gr  = gain_[i][1];
+        float dgl = (target[i][0] - gl) * inv;
+        float dgr = (target[i][1] - gr) * inv;
+        const float *p = partials[i];
+        for(size_t n = 0; n < size; n++)
+        {
+            float ramp = static_cast<float>(n + 1);
+            left[n] += p[n] * (gl + dgl * ramp);
+            right[n] += p[n] * (gr + dgr * ramp);
+        }
+        gain_[i][0] = target[i][0];
+        gain_[i][1] = target[i][1];
+    }
+}
+
+void StereoSpread::GetState(StereoSpreadState &state) const
+{
+    for(int i = 0; i < TOTAL_OSCS; i++)
+    {
+        state.drift_phase[i] = drift_phase_[i];
+        state.gain[i][0]     = gain_[i][0];
+        state.gain[i][1]     = gain_[i][1];
+    }
+}
+
+void StereoSpread::SetState(const StereoSpreadState &state)
+{
+    for(int i = 0; i < TOTAL_OSCS; i++)
+    {
+        drift_phase_[i] = state.drift_phase[i];
+        gain_[i][0]     = state.gain[i][0];
+        gain_[i][1]     = state.gain[i][1];
+    }
+}
+
+void StereoSpread::TargetGains(float target[TOTAL_OSCS][2], size_t size)
+{
+    for(int i = 0; i < TOTAL_OSCS; i++)
+    {
+        // Triangle LFO, advanced once per block
+        float ph = drift_phase_[i] + drift_inc_ * size;
+        ph -= floorf(ph);
+        drift_phase_[i] = ph;
+        float tri       = 4.f * fabsf(ph - 0.5f) - 1.f;
+
+        float pan = center_ + width_ * SPREAD_OFFSETS[i] + drift_depth_ * tri;
+        pan       = fmaxf(-1.f, fminf(pan, 1.f));
+        float x   = 0.5f * (pan + 1.f); // 0 = left, 1 = right
+
+        if(law_ == PAN_LINEAR)
+        {
+            target[i][0] = 1.f - x;
+            target[i][1] = x;
+        }
+        else
+        {
+            target[i][0] = cosf(x * HALF_PI);
+            target[i][1] = sinf(x * HALF_PI);
+        }
+    }
+}
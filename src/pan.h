@@ -0,0 +1,91 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include "block.h"
+#include "osc.h"
+
+#include <cstddef>
+
+enum PanLaw
+{
+    PAN_EQUAL_POWER, // Constant power, louder at center when summed to mono
+    PAN_LINEAR,      // L + R = 1, mono-compatible summing
+    PAN_LAST,
+};
+
+// Drift and gain ramp state, for snapshots
+struct StereoSpreadState
+{
+    float drift_phase[TOTAL_OSCS];
+    float gain[TOTAL_OSCS][2];
+};
+
+// -------------------------------------------------
+// StereoSpread
+// -------------------------------------------------
+// Pans each partial of a voice to its own position. Per block, a
+// (partials x 2) gain matrix is computed and ramped linearly from the
+// previous block's gains, so the mix is a set of straight multiply-add
+// loops over the block.
+class StereoSpread
+{
+  public:
+    StereoSpread();
+    void Init(float sr);
+    void SetCenter(float pan);
+    void SetWidth(float width);
+    void SetDrift(float depth, float rate_hz);
+    void SetLaw(PanLaw law);
+    // Mixes the partial buffers into `left`/`right`, overwriting them.
+    void Process(const float partials[TOTAL_OSCS][MAX_BLOCK_SIZE],
+                 float *left, float *right, size_t size);
+    void GetState(StereoSpreadState &state) const;
+    void SetState(const StereoSpreadState &state);
+
+  private:
+    float samplerate_;
+    float center_;
+    float width_;
+    float drift_depth_;
+    float drift_inc_;
+    PanLaw law_;
+    float drift_phase_[TOTAL_OSCS];
+    float gain_[TOTAL_OSCS][2];
+    void TargetGains(float target[TOTAL_OSCS][2], size_t size);
+};
+
+extern StereoSpread osc1_spread;
+extern StereoSpread osc2_spread;
+
+extern float  osc1_pan;         // Voice center (-1 to 1)
+extern float  osc2_pan;         // Voice center (-1 to 1)
+extern float  stereo_width;     // Partial spread (0 = mono)
+extern float  pan_drift_depth;  // Drift amount (0 to 1)
+extern float  pan_drift_rate;   // Drift rate (Hz)
+extern PanLaw pan_law;
@@ -0,0 +1,254 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#include "daisy_seed.h"
+#include "saturator.h"
+#include "budget.h"
+
+#include <cmath>
+
+Saturator DTCM_MEM_SECTION output_saturator;
+
+static_assert(sizeof(output_saturator) <= BUDGET_DTCM_OUTPUT,
+              "output saturator over budget");
+
+SaturatorMode output_sat_mode   = SAT_TANH;
+float         output_drive      = 1.0f;  // Pre-gain into the shaper
+float         output_ceiling    = 0.9f;  // Limiter threshold (linear)
+bool          output_oversample = false; // Run the shaper at 2x
+
+static constexpr float TABLE_SCALE
+    = (Saturator::TABLE_SIZE - 1) / (2.f * Saturator::TABLE_RANGE);
+
+// Odd taps h[1], h[3], ... of a Kaiser (beta 5) windowed half-band
+// lowpass at 2x; h[0] is 0.5 and the other even taps are zero. They sum
+// to 0.25 so both the interpolator and the decimator have unity DC gain.
+static const float halfband[SAT_HALFBAND_TAPS] = {
+    3.168643136e-01f,
+    -1.009824528e-01f,
+    5.531690879e-02f,
+    -3.435795912e-02f,
+    2.203452279e-02f,
+    -1.399721639e-02f,
+    8.560989063e-03f,
+    -4.897368584e-03f,
+    2.510265801e-03f,
+    -1.052003153e-03f,
+};
+
+Saturator::Saturator()
+{
+    mode_       = SAT_TANH;
+    samplerate_ = 48000.f;
+    drive_      = 1.f;
+    ceiling_    = 0.9f;
+    oversample_ = false;
+    Init(samplerate_);
+}
+
+void Saturator::Init(float sr)
+{
+    samplerate_ = sr;
+    env_        = 0.f;
+    ClearHistory();
+    SetRelease(0.1f);
+    BuildTable();
+}
+
+void Saturator::SetMode(SaturatorMode mode)
+{
+    if(mode == mode_)
+        return;
+    mode_ = mode;
+    BuildTable();
+}
+
+void Saturator::SetDrive(float drive)
+{
+    drive_ = fmaxf(drive, 0.f);
+}
+
+void Saturator::SetCeiling(float ceiling)
+{
+    ceiling_ = fmaxf(0.01f, fminf(ceiling, 1.f));
+}
+
+void Saturator::SetRelease(float seconds)
+{
+    release_coef_ = expf(-1.f / (fmaxf(seconds, 0.001f) * samplerate_));
+}
+
+void Saturator::SetOversampling(bool enabled)
+{
+    // Stale history from the last time it ran would click
+    if(enabled && !oversample_)
+        ClearHistory();
+    oversample_ = enabled;
+}
+
+void Saturator::Process(float *left, float *right, size_t size)
+{
+    if(mode_ == SAT_OFF)
+        return;
+
+    for(size_t n = 0; n < size; n++)
+    {
+        float l, r;
+        if(oversample_)
+        {
+            l = ShapeOversampled(left[n] * drive_, 0);
+            r = ShapeOversampled(right[n] * drive_, 1);
+            if(++pos_ == SAT_HISTORY)
+                pos_ = 0;
+        }
+        else
+        {
+            l = Shape(left[n] * drive_);
+            r = Shape(right[n] * drive_);
+        }
+
+        // Peak follower on the shaped signal: instant attack,
+        // exponential release
+        float peak = fmaxf(fabsf(l), fabsf(r));
+        env_       = fmaxf(peak, env_ * release_coef_);
+        if(env_ > ceiling_)
+        {
+            float gain = ceiling_ / env_;
+            l *= gain;
+            r *= gain;
+        }
+
+        left[n]  = l;
+        right[n] = r;
+    }
+}
+
+void Saturator::GetState(SaturatorState &state) const
+{
+    state.env = env_;
+    for(int ch = 0; ch < 2; ch++)
+    {
+        for(int i = 0; i < SAT_HISTORY; i++)
+        {
+            state.up[ch][i]   = up_[ch][pos_ + 1 + i];
+            state.even[ch][i] = even_[ch][pos_ + 1 + i];
+            state.odd[ch][i]  = odd_[ch][pos_ + 1 + i];
+        }
+    }
+}
+
+void Saturator::SetState(const SaturatorState &state)
+{
+    // Window starts at 1 with the ring at 0; index 0 is rewritten before
+    // anything reads it
+    env_ = state.env;
+    pos_ = 0;
+    for(int ch = 0; ch < 2; ch++)
+    {
+        for(int i = 0; i < SAT_HISTORY; i++)
+        {
+            up_[ch][1 + i]   = state.up[ch][i];
+            even_[ch][1 + i] = state.even[ch][i];
+            odd_[ch][1 + i]  = state.odd[ch][i];
+        }
+    }
+}
+
+void Saturator::BuildTable()
+{
+    for(int i = 0; i < TABLE_SIZE; i++)
+    {
+        float x = i / TABLE_SCALE - TABLE_RANGE;
+        float y;
+        switch(mode_)
+        {
+            case SAT_SOFT:
+                y = (fabsf(x) >= 1.f) ? copysignf(1.f, x)
+                                      : 1.5f * x - 0.5f * x * x * x;
+                break;
+            case SAT_TANH: y = tanhf(x); break;
+            default: y = x; break;
+        }
+        table_[i] = y;
+    }
+    // Guard point so the interpolation never reads past the end
+    table_[TABLE_SIZE] = table_[TABLE_SIZE - 1];
+}
+
+float Saturator::Shape(float x) const
+{
+    float pos = (x + TABLE_RANGE) * TABLE_SCALE;
+    pos       = fmaxf(0.f, fminf(pos, TABLE_SIZE - 1.f));
+    int   i   = static_cast<int>(pos);
+    float f   = pos - i;
+    return table_[i] + (table_[i + 1] - table_[i]) * f;
+}
+
+void Saturator::ClearHistory()
+{
+    pos_ = 0;
+    for(int ch = 0; ch < 2; ch++)
+    {
+        for(int i = 0; i < 2 * SAT_HISTORY; i++)
+        {
+            up_[ch][i]   = 0.f;
+            even_[ch][i] = 0.f;
+            odd_[ch][i]  = 0.f;
+        }
+    }
+}
+
+// Writes `x` at the ring position and its mirror, and returns the window
+// of the last SAT_HISTORY values, oldest first
+static const float *Push(float *ring, int pos, float x)
+{
+    ring[pos]               = x;
+    ring[pos + SAT_HISTORY] = x;
+    return ring + pos + 1;
+}
+
+float Saturator::ShapeOversampled(float x, int ch)
+{
+    constexpr int M = SAT_HALFBAND_TAPS;
+
+    // Up: the even 2x sample is the input itself, delayed to the filter
+    // centre; the odd one is interpolated halfway to the next input.
+    const float *in  = Push(up_[ch], pos_, x);
+    float        mid = 0.f;
+    for(int j = 0; j < M; j++)
+        mid += halfband[j] * (in[M - 1 - j] + in[M + j]);
+
+    const float *even = Push(even_[ch], pos_, Shape(in[M - 1]));
+    const float *odd  = Push(odd_[ch], pos_, Shape(2.f * mid));
+
+    // Down: the same half-band around an even sample, keeping every
+    // other output. Only the odd samples meet nonzero taps.
+    float y = 0.5f * even[M];
+    for(int j = 0; j < M; j++)
+        y += halfband[j] * (odd[M - 1 - j] + odd[M + j]);
+    return y;
+}
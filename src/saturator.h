@@ -0,0 +1,104 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+
+enum SaturatorMode
+{
+    SAT_OFF,  // Bypass, the codec clips at full scale
+    SAT_SOFT, // Cubic soft clip
+    SAT_TANH, // Hyperbolic tangent
+    SAT_LAST,
+};
+
+// Nonzero taps on each side of the half-band filter centre
+static constexpr int SAT_HALFBAND_TAPS = 10;
+static constexpr int SAT_HISTORY       = 2 * SAT_HALFBAND_TAPS;
+
+// Limiter envelope and oversampling history, oldest first, for snapshots
+struct SaturatorState
+{
+    float env;
+    float up[2][SAT_HISTORY];
+    float even[2][SAT_HISTORY];
+    float odd[2][SAT_HISTORY];
+};
+
+// -------------------------------------------------
+// Saturator
+// -------------------------------------------------
+// Output stage: a waveshaper read from a precomputed, linearly
+// interpolated table, driven by the drive gain, followed by a peak
+// limiter with instant attack (no lookahead) as the final ceiling. The
+// shaper optionally runs at 2x between a 39-tap polyphase half-band
+// interpolator and decimator: flat to 20kHz at 48kHz, images and aliases
+// down 52dB, 19 samples of latency.
+class Saturator
+{
+  public:
+    static constexpr int   TABLE_SIZE  = 1024;
+    static constexpr float TABLE_RANGE = 4.f; // input span is +/- range
+
+    Saturator();
+    void Init(float sr);
+    void SetMode(SaturatorMode mode);
+    void SetDrive(float drive);
+    void SetCeiling(float ceiling);
+    void SetRelease(float seconds);
+    void SetOversampling(bool enabled);
+    void Process(float *left, float *right, size_t size);
+    void GetState(SaturatorState &state) const;
+    void SetState(const SaturatorState &state);
+
+  private:
+    SaturatorMode mode_;
+    float samplerate_;
+    float drive_;
+    float ceiling_;
+    float release_coef_;
+    bool oversample_;
+    float env_;
+    // Doubled rings so each window reads contiguously from pos_ + 1
+    float up_[2][2 * SAT_HISTORY];
+    float even_[2][2 * SAT_HISTORY];
+    float odd_[2][2 * SAT_HISTORY];
+    int pos_;
+    float table_[TABLE_SIZE + 1];
+    void BuildTable();
+    float Shape(float x) const;
+    void ClearHistory();
+    float ShapeOversampled(float x, int ch);
+};
+
+extern Saturator output_saturator;
+
+extern SaturatorMode output_sat_mode;
+extern float         output_drive;
+extern float         output_ceiling;
+extern bool          output_oversample;
@@ -0,0 +1,156 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#include "snapshot.h"
+
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<DspSnapshot>::value,
+              "snapshots are serialized with memcpy");
+static_assert(std::is_trivially_copyable<DspTails>::value,
+              "tails are stored with memcpy");
+
+static void CapturePhases(const PhaseOscillator *oscs, float *phases)
+{
+    for(int i = 0; i < TOTAL_OSCS; i++)
+        phases[i] = oscs[i].Phase();
+}
+
+static void RestorePhases(PhaseOscillator *oscs, const float *phases)
+{
+    for(int i = 0; i < TOTAL_OSCS; i++)
+        oscs[i].SetPhase(phases[i]);
+}
+
+void CaptureSnapshot(DspSnapshot &snap, DspTails *tails)
+{
+    memset(&snap, 0, sizeof(snap));
+    snap.magic   = SNAPSHOT_MAGIC;
+    snap.version = SNAPSHOT_VERSION;
+    snap.size    = sizeof(snap);
+
+    CapturePhases(osc1_sine, snap.osc1_sine);
+    CapturePhases(osc1_saw, snap.osc1_saw);
+    CapturePhases(osc2_sine, snap.osc2_sine);
+    CapturePhases(osc2_square, snap.osc2_square);
+
+    osc1_env.GetState(snap.osc1_env);
+    osc2_env.GetState(snap.osc2_env);
+
+    formant_bank.GetState(snap.formant_z1, snap.formant_z2);
+
+    osc1_spread.GetState(snap.osc1_spread);
+    osc2_spread.GetState(snap.osc2_spread);
+    output_saturator.GetState(snap.output);
+
+    osc1_tuning.GetState(snap.osc1_tuning);
+    osc2_tuning.GetState(snap.osc2_tuning);
+
+    memcpy(snap.pot_values, pot_values, sizeof(snap.pot_values));
+    memcpy(snap.pot_stable, pot_stable, sizeof(snap.pot_stable));
+    memcpy(snap.cv_values, cv_values, sizeof(snap.cv_values));
+    memcpy(snap.cv_stable, cv_stable, sizeof(snap.cv_stable));
+    snap.osc1_volume = osc1_volume;
+    snap.osc2_volume = osc2_volume;
+
+    if(tails)
+    {
+        fx.GetState(tails->fx, tails->fx_lines);
+        body_convolver.GetState(tails->body);
+    }
+}
+
+bool RestoreSnapshot(const DspSnapshot &snap, const DspTails *tails)
+{
+    if(snap.magic != SNAPSHOT_MAGIC || snap.version != SNAPSHOT_VERSION
+       || snap.size != sizeof(snap))
+        return false;
+
+    // Parameters first: the control graph rewrites coefficients and
+    // oscillator frequencies, but no filter or oscillator state.
+    memcpy(pot_values, snap.pot_values, sizeof(pot_values));
+    memcpy(pot_stable, snap.pot_stable, sizeof(pot_stable));
+    memcpy(cv_values, snap.cv_values, sizeof(cv_values));
+    memcpy(cv_stable, snap.cv_stable, sizeof(cv_stable));
+    osc1_volume = snap.osc1_volume;
+    osc2_volume = snap.osc2_volume;
+
+    osc1_tuning.SetState(snap.osc1_tuning);
+    osc2_tuning.SetState(snap.osc2_tuning);
+
+    RefreshControls();
+    UpdateOsc1Frequencies();
+    UpdateOsc2Frequencies();
+
+    RestorePhases(osc1_sine, snap.osc1_sine);
+    RestorePhases(osc1_saw, snap.osc1_saw);
+    RestorePhases(osc2_sine, snap.osc2_sine);
+    RestorePhases(osc2_square, snap.osc2_square);
+
+    osc1_env.SetState(snap.osc1_env);
+    osc2_env.SetState(snap.osc2_env);
+
+    formant_bank.SetState(snap.formant_z1, snap.formant_z2);
+
+    osc1_spread.SetState(snap.osc1_spread);
+    osc2_spread.SetState(snap.osc2_spread);
+    output_saturator.SetState(snap.output);
+
+    if(tails)
+    {
+        fx.SetState(tails->fx, tails->fx_lines);
+        body_convolver.SetState(tails->body);
+    }
+    else
+    {
+        fx.Clear();
+        body_convolver.Reset();
+    }
+    return true;
+}
+
+size_t SerializeSnapshot(const DspSnapshot &snap,
+                         uint8_t           *buffer,
+                         size_t             capacity)
+{
+    if(capacity < sizeof(snap))
+        return 0;
+    memcpy(buffer, &snap, sizeof(snap));
+    return sizeof(snap);
+}
+
+bool DeserializeSnapshot(const uint8_t *buffer,
+                         size_t         length,
+                         DspSnapshot   &snap)
+{
+    if(length != sizeof(snap))
+        return false;
+    memcpy(&snap, buffer, sizeof(snap));
+    return snap.magic == SNAPSHOT_MAGIC && snap.version == SNAPSHOT_VERSION
+           && snap.size == sizeof(snap);
+}
@@ -0,0 +1,117 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include "osc.h"
+#include "env.h"
+#include "filter.h"
+#include "pan.h"
+#include "saturator.h"
+#include "tuning.h"
+#include "control.h"
+#include "fx.h"
+#include "conv.h"
+
+#include <cstddef>
+#include <cstdint>
+
+static constexpr uint32_t SNAPSHOT_MAGIC   = 0x534c5541; // "AULS"
+static constexpr uint32_t SNAPSHOT_VERSION = 3;
+
+static constexpr int FORMANT_STAGES = FormantBank<FORMANT_LANES>::NUM_STAGES;
+
+// -------------------------------------------------
+// DspSnapshot
+// -------------------------------------------------
+// Everything needed to resume the voice path sample-exactly: oscillator
+// phases, envelope segments, formant filter state, panning and limiter
+// state, tuning position and the parameter inputs. The delay lines and
+// convolver history live in a separate DspTails (below).
+struct DspSnapshot
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+
+    // Oscillator phases (cycles)
+    float osc1_sine[TOTAL_OSCS];
+    float osc1_saw[TOTAL_OSCS];
+    float osc2_sine[TOTAL_OSCS];
+    float osc2_square[TOTAL_OSCS];
+
+    EnvelopeState osc1_env;
+    EnvelopeState osc2_env;
+
+    float formant_z1[FORMANT_STAGES][FORMANT_LANES];
+    float formant_z2[FORMANT_STAGES][FORMANT_LANES];
+
+    StereoSpreadState osc1_spread;
+    StereoSpreadState osc2_spread;
+    SaturatorState    output;
+
+    TuningState osc1_tuning;
+    TuningState osc2_tuning;
+
+    // Parameters; everything derived from the pots and CVs is recomputed
+    float pot_values[NUM_POTS];
+    float pot_stable[NUM_POTS];
+    float cv_values[NUM_CV];
+    float cv_stable[NUM_CV];
+    float osc1_volume;
+    float osc2_volume;
+};
+
+// -------------------------------------------------
+// DspTails
+// -------------------------------------------------
+// Delay, reverb and body convolver contents. About 1.9MB, so optional:
+// host renders keep one next to the snapshot, the firmware need not.
+// Restoring without it starts those stages silent, and the resumed
+// output then only matches while the sends and body stage are off.
+struct DspTails
+{
+    SendEffectsState fx;
+    float fx_lines[SendEffects::LINE_SAMPLES];
+    ConvolverState body;
+};
+
+void CaptureSnapshot(DspSnapshot &snap, DspTails *tails = nullptr);
+
+// Restores a captured state. Call with audio stopped. `tails` must come
+// from the same capture as `snap`.
+bool RestoreSnapshot(const DspSnapshot &snap, const DspTails *tails = nullptr);
+
+// Flat byte form for storage or transfer. Returns the number of bytes
+// written, or 0 when `capacity` is too small.
+size_t SerializeSnapshot(const DspSnapshot &snap,
+                         uint8_t           *buffer,
+                         size_t             capacity);
+
+bool DeserializeSnapshot(const uint8_t *buffer,
+                         size_t         length,
+                         DspSnapshot   &snap);
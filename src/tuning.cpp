@@ -0,0 +1,245 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#include "tuning.h"
+#include "budget.h"
+
+#include <cmath>
+#include <cstring>
+
+// Scales are built upwards from C0 and cover the full root range
+static constexpr float TUNING_BASE_FREQ = 16.3516f;
+static constexpr float TUNING_MAX_FREQ  = 5000.f;
+
+// Degree ratios per octave
+static const float EQUAL_RATIOS[12] = {
+    1.f,
+    1.059463f,
+    1.122462f,
+    1.189207f,
+    1.259921f,
+    1.334840f,
+    1.414214f,
+    1.498307f,
+    1.587401f,
+    1.681793f,
+    1.781797f,
+    1.887749f,
+};
+
+static const float JUST_RATIOS[12] = {
+    1.f,
+    16.f / 15.f,
+    9.f / 8.f,
+    6.f / 5.f,
+    5.f / 4.f,
+    4.f / 3.f,
+    45.f / 32.f,
+    3.f / 2.f,
+    8.f / 5.f,
+    5.f / 3.f,
+    9.f / 5.f,
+    15.f / 8.f,
+};
+
+static const uint8_t MIXTURE_DIVISORS[MIXTURE_LAST][NUM_SUBS] = {
+    {2, 3, 4, 5},
+    {2, 4, 8, 16},
+    {3, 5, 7, 9},
+    {3, 6, 9, 12},
+};
+
+Tuning osc1_tuning;
+Tuning osc2_tuning;
+
+static_assert(sizeof(osc1_tuning) + sizeof(osc2_tuning) <= BUDGET_SRAM_TUNING,
+              "tuning tables over budget");
+
+// Build-time settings. Every panel control already has a labelled job,
+// so the scale, mixture and hysteresis are fixed here and applied once by
+// InitAudio(). SCALE_CONTINUOUS leaves the quantizer out of the path.
+TuningScale   osc1_scale            = SCALE_CONTINUOUS;
+TuningMixture osc1_mixture          = MIXTURE_INTEGER;
+float         osc1_pitch_hysteresis = 0.1f; // semitones
+
+TuningScale   osc2_scale            = SCALE_CONTINUOUS;
+TuningMixture osc2_mixture          = MIXTURE_INTEGER;
+float         osc2_pitch_hysteresis = 0.1f; // semitones
+
+Tuning::Tuning()
+{
+    sr_recip_   = 1.f / 48000.f;
+    scale_      = SCALE_CONTINUOUS;
+    hysteresis_ = 0.1f;
+    num_notes_  = 0;
+    note_       = -1;
+    root_       = 0.f;
+    pitch_      = 0.f;
+    memset(partials_, 0, sizeof(partials_));
+    SetMixture(MIXTURE_INTEGER);
+}
+
+void Tuning::Init(float sr)
+{
+    sr_recip_ = 1.f / sr;
+    Rebuild();
+}
+
+void Tuning::SetScale(TuningScale scale)
+{
+    scale_ = scale;
+    Rebuild();
+}
+
+void Tuning::SetMixture(TuningMixture mixture)
+{
+    SetDivisors(MIXTURE_DIVISORS[mixture]);
+}
+
+void Tuning::SetDivisors(const uint8_t divisors[NUM_SUBS])
+{
+    sub_ratio_[0] = 1.f;
+    for(int i = 0; i < NUM_SUBS; i++)
+    {
+        divisors_[i]      = divisors[i] > 0 ? divisors[i] : 1;
+        sub_ratio_[i + 1] = 1.f / divisors_[i];
+    }
+    Rebuild();
+}
+
+void Tuning::SetHysteresis(float semitones)
+{
+    hysteresis_ = fmaxf(0.f, semitones);
+}
+
+bool Tuning::SetPitch(float freq)
+{
+    root_  = freq;
+    pitch_ = 12.f * log2f(fmaxf(freq, TUNING_BASE_FREQ) / TUNING_BASE_FREQ);
+
+    if(scale_ == SCALE_CONTINUOUS)
+    {
+        float inc = freq * sr_recip_;
+        for(int i = 0; i < TOTAL_OSCS; i++)
+            partials_[i] = inc * sub_ratio_[i];
+        return true;
+    }
+
+    int candidate = Nearest(pitch_);
+    if(candidate == note_)
+        return false;
+    if(note_ >= 0)
+    {
+        // Only leave the current note once the pitch is clearly closer
+        // to the candidate.
+        float d_current   = fabsf(pitch_ - note_pitch_[note_]);
+        float d_candidate = fabsf(pitch_ - note_pitch_[candidate]);
+        if(d_current - d_candidate < hysteresis_)
+            return false;
+    }
+    note_ = candidate;
+    memcpy(partials_, note_partials_[note_], sizeof(partials_));
+    return true;
+}
+
+void Tuning::GetState(TuningState &state) const
+{
+    state.scale = scale_;
+    memcpy(state.divisors, divisors_, sizeof(state.divisors));
+    state.note  = note_;
+    state.root  = root_;
+    state.pitch = pitch_;
+}
+
+void Tuning::SetState(const TuningState &state)
+{
+    scale_ = (state.scale >= 0 && state.scale < SCALE_LAST)
+                 ? static_cast<TuningScale>(state.scale)
+                 : SCALE_CONTINUOUS;
+    root_  = state.root;
+    pitch_ = state.pitch;
+    SetDivisors(state.divisors);
+
+    if(scale_ == SCALE_CONTINUOUS || state.note < 0 || state.note >= num_notes_)
+    {
+        // Nothing held; re-derive the partials from the root
+        note_ = -1;
+        SetPitch(root_);
+        return;
+    }
+    note_ = state.note;
+    memcpy(partials_, note_partials_[note_], sizeof(partials_));
+}
+
+void Tuning::Rebuild()
+{
+    if(scale_ == SCALE_CONTINUOUS)
+    {
+        float inc = root_ * sr_recip_;
+        for(int i = 0; i < TOTAL_OSCS; i++)
+            partials_[i] = inc * sub_ratio_[i];
+        num_notes_ = 0;
+        note_      = -1;
+        return;
+    }
+
+    const float *ratios = (scale_ == SCALE_JUST) ? JUST_RATIOS : EQUAL_RATIOS;
+
+    num_notes_ = 0;
+    for(int octave = 0; num_notes_ < MAX_NOTES; octave++)
+    {
+        float octave_freq = TUNING_BASE_FREQ * static_cast<float>(1 << octave);
+        if(octave_freq > TUNING_MAX_FREQ)
+            break;
+        for(int d = 0; d < 12 && num_notes_ < MAX_NOTES; d++)
+        {
+            float freq = octave_freq * ratios[d];
+            float inc  = freq * sr_recip_;
+            note_pitch_[num_notes_] = 12.f * log2f(freq / TUNING_BASE_FREQ);
+            for(int i = 0; i < TOTAL_OSCS; i++)
+                note_partials_[num_notes_][i] = inc * sub_ratio_[i];
+            num_notes_++;
+        }
+    }
+
+    // Snap the last pitch onto the new tables
+    note_ = Nearest(pitch_);
+    memcpy(partials_, note_partials_[note_], sizeof(partials_));
+}
+
+int Tuning::Nearest(float pitch) const
+{
+    // Tables are ascending, so a linear scan can stop at the first note
+    // above the pitch.
+    int i = 0;
+    while(i < num_notes_ - 1 && note_pitch_[i + 1] < pitch)
+        i++;
+    if(i < num_notes_ - 1
+       && fabsf(note_pitch_[i + 1] - pitch) < fabsf(pitch - note_pitch_[i]))
+        i++;
+    return i;
+}
@@ -0,0 +1,117 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include "osc.h"
+
+#include <cstdint>
+
+enum TuningScale
+{
+    SCALE_CONTINUOUS, // Unquantized root frequency
+    SCALE_EQUAL,      // 12-tone equal temperament
+    SCALE_JUST,       // 5-limit just intonation, 12 degrees
+    SCALE_LAST,
+};
+
+// Subharmonic divisor sets, after the Trautonium "Mixturen"
+enum TuningMixture
+{
+    MIXTURE_INTEGER, // 1/2 1/3 1/4 1/5
+    MIXTURE_OCTAVES, // 1/2 1/4 1/8 1/16
+    MIXTURE_ODD,     // 1/3 1/5 1/7 1/9
+    MIXTURE_FIFTHS,  // 1/3 1/6 1/9 1/12
+    MIXTURE_LAST,
+};
+
+// Scale, divisors and quantizer position, for snapshots
+struct TuningState
+{
+    int32_t scale;
+    uint8_t divisors[NUM_SUBS];
+    int32_t note;
+    float root;
+    float pitch;
+};
+
+// -------------------------------------------------
+// Tuning
+// -------------------------------------------------
+// Holds the per-voice scale and subharmonic divisors. The phase
+// increment of every partial is precomputed whenever the scale or
+// mixture changes, so following the root pitch is a table lookup that
+// feeds the oscillators directly.
+class Tuning
+{
+  public:
+    static constexpr int MAX_NOTES = 128;
+
+    Tuning();
+    void Init(float sr);
+    void SetScale(TuningScale scale);
+    void SetMixture(TuningMixture mixture);
+    void SetDivisors(const uint8_t divisors[NUM_SUBS]);
+    // Hysteresis in semitones the pitch must move past the midpoint
+    // between two notes before the quantizer switches.
+    void SetHysteresis(float semitones);
+    // Returns true when the partial increments changed.
+    bool SetPitch(float freq);
+    // Per-partial phase increments (cycles per sample)
+    const float *PartialIncrements() const { return partials_; }
+    void GetState(TuningState &state) const;
+    // Rebuilds the tables for the captured scale and divisors, then
+    // restores the held note.
+    void SetState(const TuningState &state);
+
+  private:
+    float sr_recip_;
+    TuningScale scale_;
+    float hysteresis_;
+    uint8_t divisors_[NUM_SUBS];
+    float sub_ratio_[TOTAL_OSCS];
+    int num_notes_;
+    int note_;
+    float root_;
+    float pitch_;
+    float note_pitch_[MAX_NOTES]; // semitones above TUNING_BASE_FREQ
+    float note_partials_[MAX_NOTES][TOTAL_OSCS];
+    float partials_[TOTAL_OSCS];
+    void Rebuild();
+    int Nearest(float pitch) const;
+};
+
+extern Tuning osc1_tuning;
+extern Tuning osc2_tuning;
+
+extern TuningScale   osc1_scale;
+extern TuningMixture osc1_mixture;
+extern float         osc1_pitch_hysteresis;
+
+extern TuningScale   osc2_scale;
+extern TuningMixture osc2_mixture;
+extern float         osc2_pitch_hysteresis;
@@ -0,0 +1,136 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+// Runs the audio callback with the heap guard armed across every signal
+// path and a range of block sizes. Any malloc/free or new/delete inside
+// the callback traps and fails the test.
+#include "host.h"
+#include "alloc_guard.h"
+#include "fx.h"
+#include "conv.h"
+#include "filter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static constexpr size_t FRAMES = 4800;
+
+static float left[FRAMES];
+static float right[FRAMES];
+
+// The guard must actually trap, or a clean run proves nothing. Each
+// allocation runs armed in a child process that must die on it.
+static bool GuardTraps(void (*allocate)())
+{
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        ALLOC_GUARD_ARM();
+        allocate();
+        ALLOC_GUARD_DISARM();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFSIGNALED(status);
+}
+
+static void *volatile sink;
+
+static const struct
+{
+    const char *name;
+    void (*allocate)();
+} allocations[] = {
+    {"malloc", [] { sink = malloc(16); }},
+    {"calloc", [] { sink = calloc(4, 4); }},
+    {"aligned_alloc", [] { sink = aligned_alloc(32, 64); }},
+    {"posix_memalign",
+     [] {
+         void *p = nullptr;
+         if(posix_memalign(&p, 32, 64) == 0)
+             sink = p;
+     }},
+    {"operator new", [] { sink = new float; }},
+    {"nothrow new", [] { sink = new(std::nothrow) float; }},
+    // 32-byte vector lanes take the aligned operator new
+    {"aligned new", [] { sink = new FormantBank<8>; }},
+};
+
+int main()
+{
+    for(const auto &a : allocations)
+    {
+        if(!GuardTraps(a.allocate))
+        {
+            fprintf(stderr, "alloc_test: heap guard did not trap %s\n", a.name);
+            return 1;
+        }
+    }
+
+    // Build-time stages on, so their paths run under the guard too
+    fx_delay_send  = 0.5f;
+    fx_reverb_send = 0.5f;
+    body_mix       = 0.5f;
+    HostInit();
+
+    static const float  settings[]    = {0.f, 0.3f, 0.7f, 1.f};
+    static const size_t block_sizes[] = {1, 7, 16, 48, 64, 100, 256};
+
+    for(float v : settings)
+    {
+        for(float &p : host_pots)
+            p = v;
+        for(float &c : host_cv)
+            c = 1.f - v;
+        HostApplyControls();
+
+        for(size_t block_size : block_sizes)
+        {
+            HostRender(left, right, FRAMES, block_size);
+            for(size_t n = 0; n < FRAMES; n++)
+            {
+                if(!std::isfinite(left[n]) || !std::isfinite(right[n]))
+                {
+                    fprintf(stderr,
+                            "alloc_test: non-finite output (controls %.1f, "
+                            "block %zu)\n",
+                            v,
+                            block_size);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    printf("alloc_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,385 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+// Host cost of the DSP stages. Times are wall clock on the build machine,
+// so they rank and scale stages rather than predict M7 cycle counts.
+#include "host.h"
+#include "fx.h"
+#include "saturator.h"
+#include "filter.h"
+#include "conv.h"
+#include "audio.h"
+#include "block.h"
+
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+
+static constexpr float  SAMPLE_RATE = 48000.f;
+static constexpr size_t MAX_FRAMES  = 256;
+
+static const size_t block_sizes[] = {16, 32, 48, 64, 128, 256};
+
+static float in_l[MAX_FRAMES], in_r[MAX_FRAMES];
+static float buf_l[MAX_FRAMES], buf_r[MAX_FRAMES];
+
+// Best of several runs, in nanoseconds per call
+template <typename Fn>
+static double TimeCall(Fn fn, int calls)
+{
+    double best = 1e30;
+    for(int run = 0; run < 5; run++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < calls; i++)
+            fn();
+        auto stop = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+        if(ns / calls < best)
+            best = ns / calls;
+    }
+    return best;
+}
+
+// Fraction of the real-time budget one block of `size` samples uses
+static double BlockLoad(double ns, size_t size)
+{
+    return 100.0 * ns / (1e9 * size / SAMPLE_RATE);
+}
+
+static void FillInput()
+{
+    uint32_t state = 0x2545f491;
+    for(size_t n = 0; n < MAX_FRAMES; n++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        in_l[n] = (state >> 8) * (2.f / 16777216.f) - 1.f;
+        in_r[n] = -in_l[n];
+    }
+}
+
+static void PrintBlockHeader(const char *title)
+{
+    printf("\n%s\n", title);
+    printf("  %6s %12s %10s %8s\n", "block", "ns/block", "ns/sample", "load %");
+}
+
+static void PrintBlockRow(size_t size, double ns)
+{
+    printf("  %6zu %12.0f %10.1f %8.3f\n", size, ns, ns / size, BlockLoad(ns, size));
+}
+
+static void BenchSendEffects()
+{
+    PrintBlockHeader("send effects: stereo delay + 4 line FDN reverb");
+    fx.Init(SAMPLE_RATE);
+    fx.SetDelaySend(0.5f);
+    fx.SetReverbSend(0.5f);
+    for(size_t size : block_sizes)
+    {
+        double ns = TimeCall(
+            [size] {
+                for(size_t n = 0; n < size; n++)
+                {
+                    buf_l[n] = in_l[n];
+                    buf_r[n] = in_r[n];
+                }
+                fx.Process(buf_l, buf_r, size);
+            },
+            20000);
+        PrintBlockRow(size, ns);
+    }
+}
+
+static void BenchSaturator()
+{
+    static const char *const mode_names[SAT_LAST] = {"off", "soft", "tanh"};
+
+    printf("\nsaturator/limiter at %zu samples, quiet (0.1) and hot (4.0) input\n",
+           AUDIO_BLOCK_SIZE);
+    printf("  %6s %4s %14s %14s %8s\n", "mode", "os", "quiet ns/blk", "hot ns/blk", "load %");
+
+    Saturator sat;
+    for(int mode = SAT_OFF; mode < SAT_LAST; mode++)
+    {
+        for(int os = 0; os < 2; os++)
+        {
+            sat.Init(SAMPLE_RATE);
+            sat.SetMode(static_cast<SaturatorMode>(mode));
+            sat.SetOversampling(os != 0);
+
+            double ns[2];
+            const float gains[2] = {0.1f, 4.f};
+            for(int g = 0; g < 2; g++)
+            {
+                float gain = gains[g];
+                ns[g]      = TimeCall(
+                    [&sat, gain] {
+                        for(size_t n = 0; n < AUDIO_BLOCK_SIZE; n++)
+                        {
+                            buf_l[n] = in_l[n] * gain;
+                            buf_r[n] = in_r[n] * gain;
+                        }
+                        sat.Process(buf_l, buf_r, AUDIO_BLOCK_SIZE);
+                    },
+                    100000);
+            }
+            printf("  %6s %4s %14.0f %14.0f %8.3f\n",
+                   mode_names[mode],
+                   os ? "2x" : "1x",
+                   ns[0],
+                   ns[1],
+                   BlockLoad(ns[1], AUDIO_BLOCK_SIZE));
+        }
+    }
+}
+
+// One lane through the same three stage cascade, a sample at a time
+struct ScalarFormant
+{
+    BiquadFilter stages[3];
+    float        amp = 1.f, mix = 1.f;
+
+    void Process(float *buf, size_t size)
+    {
+        for(size_t n = 0; n < size; n++)
+        {
+            float dry = buf[n];
+            float y   = dry;
+            for(BiquadFilter &f : stages)
+                y = f.Process(y);
+            buf[n] = dry + (y * amp - dry) * mix;
+        }
+    }
+};
+
+static float lane_bufs[8][MAX_FRAMES];
+
+template <int LANES>
+static double TimeFormantBank()
+{
+    static FormantBank<LANES> bank;
+    bank.Init(SAMPLE_RATE);
+    float *lanes[LANES];
+    for(int l = 0; l < LANES; l++)
+    {
+        bank.SetLane(l, 400.f + 150.f * l, 120.f, 2.f, 1.f);
+        bank.SetMix(l, 1.f);
+        lanes[l] = lane_bufs[l];
+    }
+    return TimeCall(
+        [&lanes] {
+            for(int l = 0; l < LANES; l++)
+                for(size_t n = 0; n < AUDIO_BLOCK_SIZE; n++)
+                    lanes[l][n] = in_l[n];
+            bank.Process(lanes, AUDIO_BLOCK_SIZE);
+        },
+        100000);
+}
+
+static double TimeScalarFormants(int lanes)
+{
+    static ScalarFormant filters[8];
+    for(int l = 0; l < lanes; l++)
+        for(BiquadFilter &f : filters[l].stages)
+            f.SetBandPass(SAMPLE_RATE, 400.f + 150.f * l, 120.f / 2.f);
+    return TimeCall(
+        [lanes] {
+            for(int l = 0; l < lanes; l++)
+            {
+                for(size_t n = 0; n < AUDIO_BLOCK_SIZE; n++)
+                    lane_bufs[l][n] = in_l[n];
+                filters[l].Process(lane_bufs[l], AUDIO_BLOCK_SIZE);
+            }
+        },
+        100000);
+}
+
+static void BenchFormantBank()
+{
+    printf("\nformant bank at %zu samples, 3 stages per lane\n", AUDIO_BLOCK_SIZE);
+    printf("  %6s %12s %16s %16s %9s\n",
+           "lanes", "ns/block", "ns/lane-sample", "scalar ns/block", "speedup");
+
+    const int    counts[3] = {2, 4, 8};
+    const double bank_ns[3]
+        = {TimeFormantBank<2>(), TimeFormantBank<4>(), TimeFormantBank<8>()};
+    for(int i = 0; i < 3; i++)
+    {
+        double scalar_ns = TimeScalarFormants(counts[i]);
+        printf("  %6d %12.0f %16.2f %16.0f %8.2fx\n",
+               counts[i],
+               bank_ns[i],
+               bank_ns[i] / (counts[i] * AUDIO_BLOCK_SIZE),
+               scalar_ns,
+               scalar_ns / bank_ns[i]);
+    }
+}
+
+// Whole callback with the body stage off
+static void BenchCallback()
+{
+    PrintBlockHeader("audio callback, body stage off");
+    for(float &p : host_pots)
+        p = 0.5f;
+    HostApplyControls();
+
+    for(size_t size : block_sizes)
+    {
+        double ns = TimeCall(
+            [size] {
+                float *out[2] = {buf_l, buf_r};
+                AudioCallback(nullptr, out, size);
+            },
+            5000);
+        PrintBlockRow(size, ns);
+    }
+}
+
+// Share of the host block period the body stage may take in its worst
+// callback. The 480MHz M7 runs these float loops some 10-30x slower than
+// a desktop core, so 1% here stands for 10-30% of the device's period.
+// MAX_IR_LENGTH is the longest power of two that fits.
+static constexpr double BODY_LOAD_BUDGET = 1.0; // percent
+
+// Convolver cost against IR length. Blocks and partitions differ in size,
+// so only some callbacks run an FFT partition; the average hides those.
+// Each callback in one partition cycle is timed on its own (best of many
+// cycles, to drop preemption) and the worst one is what must fit. Its
+// cost is a fixed part (direct head and FFTs) plus a multiply-accumulate
+// per tail partition, so a line through it predicts longer responses.
+static void BenchConvolver()
+{
+    constexpr size_t BLOCK = AUDIO_BLOCK_SIZE;
+    constexpr size_t CYCLE
+        = Convolver::PARTITION_SIZE / std::gcd(BLOCK, Convolver::PARTITION_SIZE);
+    constexpr int REPEATS = 4000;
+
+    printf("\nbody convolver at %zu samples, %zu callbacks per partition cycle\n",
+           BLOCK,
+           CYCLE);
+    printf("  %6s %12s %12s %12s\n", "ir", "mean ns/blk", "worst ns/blk", "worst load %");
+
+    static Convolver conv;
+    static float     ir[Convolver::MAX_IR_LENGTH];
+    MakeBodyImpulse(ir, Convolver::MAX_IR_LENGTH, SAMPLE_RATE);
+    conv.SetMix(0.5f);
+
+    // Least squares over lengths with at least one tail partition
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    int    points = 0;
+    for(size_t len = Convolver::PARTITION_SIZE; len <= Convolver::MAX_IR_LENGTH;
+        len *= 2)
+    {
+        conv.Init();
+        conv.SetImpulse(ir, len);
+
+        // Every repeat runs a whole cycle, so callback c always lands on
+        // the same partition phase
+        double best[CYCLE];
+        for(double &b : best)
+            b = 1e30;
+        for(int rep = 0; rep < REPEATS; rep++)
+        {
+            for(size_t c = 0; c < CYCLE; c++)
+            {
+                for(size_t n = 0; n < BLOCK; n++)
+                {
+                    buf_l[n] = in_l[n];
+                    buf_r[n] = in_r[n];
+                }
+                auto start = std::chrono::steady_clock::now();
+                conv.Process(buf_l, buf_r, BLOCK);
+                auto   stop = std::chrono::steady_clock::now();
+                double ns
+                    = std::chrono::duration<double, std::nano>(stop - start).count();
+                if(ns < best[c])
+                    best[c] = ns;
+            }
+        }
+
+        double mean = 0.0, worst = 0.0;
+        for(double b : best)
+        {
+            mean += b / CYCLE;
+            worst = b > worst ? b : worst;
+        }
+        printf("  %6zu %12.0f %12.0f %12.3f\n",
+               len,
+               mean,
+               worst,
+               BlockLoad(worst, BLOCK));
+
+        double partitions = len / Convolver::PARTITION_SIZE - 1.0;
+        if(partitions >= 1.0)
+        {
+            sx += partitions;
+            sy += worst;
+            sxx += partitions * partitions;
+            sxy += partitions * worst;
+            points++;
+        }
+    }
+
+    double slope = (points * sxy - sx * sy) / (points * sxx - sx * sx);
+    double fixed = (sy - slope * sx) / points;
+    printf("  worst callback: %.0f ns fixed + %.0f ns per partition\n", fixed, slope);
+    if(slope <= 0.0)
+    {
+        printf("  fit does not rise with length; rerun on a quiet machine\n");
+        return;
+    }
+    double budget_ns = BODY_LOAD_BUDGET / 100.0 * 1e9 * BLOCK / SAMPLE_RATE;
+    long   tail      = static_cast<long>((budget_ns - fixed) / slope);
+    size_t limit     = tail < 0 ? 0 : (tail + 1) * Convolver::PARTITION_SIZE;
+    size_t pow2      = Convolver::PARTITION_SIZE;
+    while(pow2 * 2 <= limit)
+        pow2 *= 2;
+    printf("  longest IR within %.1f%% of the block period: %zu samples, "
+           "%zu as a power of two (MAX_IR_LENGTH %zu)\n",
+           BODY_LOAD_BUDGET,
+           limit,
+           pow2,
+           Convolver::MAX_IR_LENGTH);
+}
+
+int main()
+{
+    HostInit(SAMPLE_RATE);
+    FillInput();
+    printf("host timings at %.0f Hz; load %% is of one block period\n", SAMPLE_RATE);
+
+    BenchSendEffects();
+    BenchSaturator();
+    BenchFormantBank();
+
+    BenchCallback();
+    BenchConvolver();
+    return 0;
+}
@@ -0,0 +1,129 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+// Checks the partitioned FFT convolver against direct convolution, left
+// and right with different inputs so the stereo packing is covered, for
+// response lengths on and off the partition grid.
+#include "conv.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+static constexpr size_t FRAMES    = 4096;
+static constexpr float  TOLERANCE = 1e-5f;
+
+static float input_l[FRAMES], input_r[FRAMES];
+static float ir[Convolver::MAX_IR_LENGTH];
+
+static Convolver conv;
+static float     out_l[FRAMES], out_r[FRAMES];
+
+static float Noise(uint32_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return (state >> 8) * (2.f / 16777216.f) - 1.f;
+}
+
+// Direct convolution of `x` with ir[0..length) at sample n, in double
+static float Direct(const float *x, size_t n, size_t length)
+{
+    double y = 0.0;
+    for(size_t k = 0; k < length && k <= n; k++)
+        y += static_cast<double>(ir[k]) * x[n - k];
+    return static_cast<float>(y);
+}
+
+static bool CheckLength(size_t length, float mix)
+{
+    // Noise response at unit energy, so output level matches the input
+    uint32_t state  = 0x9e3779b9 + static_cast<uint32_t>(length);
+    double   energy = 0.0;
+    for(size_t k = 0; k < length; k++)
+    {
+        ir[k] = Noise(state);
+        energy += ir[k] * ir[k];
+    }
+    for(size_t k = 0; k < length; k++)
+        ir[k] /= sqrt(energy);
+
+    conv.Init();
+    conv.SetImpulse(ir, length);
+    conv.SetMix(mix);
+    for(size_t n = 0; n < FRAMES; n++)
+    {
+        out_l[n] = input_l[n];
+        out_r[n] = input_r[n];
+    }
+
+    // Odd chunk sizes so partitions straddle calls
+    for(size_t offset = 0, chunk = 1; offset < FRAMES; offset += chunk, chunk++)
+    {
+        if(chunk > FRAMES - offset)
+            chunk = FRAMES - offset;
+        conv.Process(out_l + offset, out_r + offset, chunk);
+    }
+
+    for(size_t n = 0; n < FRAMES; n++)
+    {
+        float dry = 1.f - mix;
+        float l   = input_l[n] * dry + Direct(input_l, n, length) * mix;
+        float r   = input_r[n] * dry + Direct(input_r, n, length) * mix;
+        if(fabsf(out_l[n] - l) > TOLERANCE || fabsf(out_r[n] - r) > TOLERANCE)
+        {
+            fprintf(stderr,
+                    "conv_test: IR length %zu, mix %.2f differs at %zu\n",
+                    length,
+                    mix,
+                    n);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    uint32_t state = 0x2545f491;
+    for(size_t n = 0; n < FRAMES; n++)
+    {
+        input_l[n] = Noise(state);
+        input_r[n] = Noise(state);
+    }
+
+    static const size_t lengths[] = {1, 63, 64, 65, 100, 128, 1000, 1024};
+    for(size_t length : lengths)
+    {
+        if(!CheckLength(length, 1.f) || !CheckLength(length, 0.3f))
+            return 1;
+    }
+
+    printf("conv_test: ok\n");
+    return 0;
+}
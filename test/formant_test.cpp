@@ -0,0 +1,176 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+// Checks every FormantBank width against a scalar BiquadFilter cascade,
+// lane by lane, including the make-up gain and the wet/dry blend.
+#include "filter.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+static constexpr float  SAMPLE_RATE = 48000.f;
+static constexpr size_t FRAMES      = 4096;
+static constexpr float  TOLERANCE   = 1e-5f;
+
+static float input[FRAMES];
+
+template <int LANES>
+static bool CheckBank()
+{
+    static FormantBank<LANES> bank;
+    static float              buffers[LANES][FRAMES];
+    BiquadFilter              reference[LANES][FormantBank<LANES>::NUM_STAGES];
+
+    bank.Init(SAMPLE_RATE);
+    float *lanes[LANES];
+    for(int l = 0; l < LANES; l++)
+    {
+        float freq = 300.f + 250.f * l;
+        float bw   = 80.f + 20.f * l;
+        float res  = 1.f + 0.5f * l;
+        float amp  = 0.5f + 0.1f * l;
+        float mix  = (l + 1) / static_cast<float>(LANES);
+        bank.SetLane(l, freq, bw, res, amp);
+        bank.SetMix(l, mix);
+        for(BiquadFilter &f : reference[l])
+            f.SetBandPass(SAMPLE_RATE, freq, bw / res);
+
+        for(size_t n = 0; n < FRAMES; n++)
+            buffers[l][n] = input[n];
+        lanes[l] = buffers[l];
+    }
+
+    // Odd chunk sizes so state carries across calls
+    for(size_t offset = 0, chunk = 1; offset < FRAMES; offset += chunk, chunk++)
+    {
+        if(chunk > FRAMES - offset)
+            chunk = FRAMES - offset;
+        float *chunk_lanes[LANES];
+        for(int l = 0; l < LANES; l++)
+            chunk_lanes[l] = lanes[l] + offset;
+        bank.Process(chunk_lanes, chunk);
+    }
+
+    for(int l = 0; l < LANES; l++)
+    {
+        float bw  = 80.f + 20.f * l;
+        float res = 1.f + 0.5f * l;
+        float amp = (0.5f + 0.1f * l)
+                    * FormantBank<LANES>::MakeupGain(SAMPLE_RATE, bw / res);
+        float mix = (l + 1) / static_cast<float>(LANES);
+        for(size_t n = 0; n < FRAMES; n++)
+        {
+            float y = input[n];
+            for(BiquadFilter &f : reference[l])
+                y = f.Process(y);
+            float expected = input[n] + (y * amp - input[n]) * mix;
+            if(fabsf(buffers[l][n] - expected) > TOLERANCE)
+            {
+                fprintf(stderr,
+                        "formant_test: %d lanes, lane %d differs at %zu\n",
+                        LANES,
+                        l,
+                        n);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The make-up gain brings white noise back to about its input level. A
+// narrow band averages few independent samples per second, so the noise
+// runs for 20 seconds. Bands stay wide enough to sit under MAX_MAKEUP.
+static bool CheckMakeup()
+{
+    static constexpr size_t SECONDS = 20;
+    static FormantBank<2>   bank;
+    static const float      bands[][2] = {{300.f, 50.f}, {1000.f, 80.f}, {3000.f, 400.f}};
+
+    for(const auto &band : bands)
+    {
+        bank.Init(SAMPLE_RATE);
+        bank.SetLane(0, band[0], band[1], 1.f, 1.f);
+        bank.SetLane(1, band[0], band[1], 1.f, 1.f);
+
+        uint32_t state = 0x9e3779b9;
+        double   in = 0.0, out = 0.0;
+        for(size_t second = 0; second < SECONDS; second++)
+        {
+            static float buffers[2][static_cast<size_t>(SAMPLE_RATE)];
+            for(float &x : buffers[0])
+            {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                x = (state >> 8) * (2.f / 16777216.f) - 1.f;
+            }
+            for(size_t n = 0; n < static_cast<size_t>(SAMPLE_RATE); n++)
+            {
+                in += buffers[0][n] * buffers[0][n];
+                buffers[1][n] = buffers[0][n];
+            }
+            float *lanes[2] = {buffers[0], buffers[1]};
+            bank.Process(lanes, static_cast<size_t>(SAMPLE_RATE));
+            for(float x : buffers[0])
+                out += x * x;
+        }
+
+        double db = 10.0 * log10(out / in);
+        if(fabs(db) > 1.5)
+        {
+            fprintf(stderr,
+                    "formant_test: %.0fHz band of %.0fHz leaves at %+.1fdB\n",
+                    band[0],
+                    band[1],
+                    db);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    uint32_t state = 0x2545f491;
+    for(size_t n = 0; n < FRAMES; n++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        input[n] = (state >> 8) * (2.f / 16777216.f) - 1.f;
+    }
+
+    if(!CheckBank<2>() || !CheckBank<4>() || !CheckBank<8>())
+        return 1;
+    if(!CheckMakeup())
+        return 1;
+
+    printf("formant_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#include "host.h"
+#include "audio.h"
+#include "mux.h"
+
+using namespace daisy;
+
+DaisySeed hw;
+
+float host_pots[NUM_POTS];
+float host_cv[NUM_CV];
+
+// Multiplexer address, assembled from the select line writes
+static int mux_address = 0;
+
+namespace daisy
+{
+namespace seed
+{
+const Pin D2 = {0, 2};
+const Pin D3 = {0, 3};
+const Pin D4 = {0, 4};
+const Pin D5 = {0, 5};
+const Pin A0 = {0, 0};
+const Pin A1 = {0, 1};
+} // namespace seed
+
+float AdcHandle::GetFloat(uint8_t chn) const
+{
+    if(chn == 0)
+        return mux_address < NUM_POTS ? host_pots[mux_address] : 0.f;
+    return mux_address < NUM_CV ? host_cv[mux_address] : 0.f;
+}
+} // namespace daisy
+
+void dsy_gpio_init(dsy_gpio *) {}
+
+void dsy_gpio_write(dsy_gpio *p, uint8_t state)
+{
+    // S0..S3 sit on D2..D5
+    int bit = 1 << (p->pin.pin - seed::D2.pin);
+    mux_address = state ? (mux_address | bit) : (mux_address & ~bit);
+}
+
+void HostInit(float sr, uint32_t seed)
+{
+    // Unpatched jacks sit at 0V
+    for(float &c : host_cv)
+        c = CV_REST;
+    InitMultiplexerPins();
+    InitAudio(sr, seed);
+}
+
+void HostApplyControls()
+{
+    for(int i = 0; i < NUM_POTS; i++)
+        pot_values[i] = pot_stable[i] = host_pots[i];
+    for(int i = 0; i < NUM_CV; i++)
+        cv_values[i] = cv_stable[i] = host_cv[i];
+    RefreshControls();
+}
+
+void HostRender(float *left, float *right, size_t frames, size_t block_size)
+{
+    for(size_t offset = 0; offset < frames; offset += block_size)
+    {
+        size_t size  = frames - offset < block_size ? frames - offset
+                                                    : block_size;
+        float *out[2] = {left + offset, right + offset};
+        AudioCallback(nullptr, out, size);
+    }
+}
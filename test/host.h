@@ -0,0 +1,49 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+#include "control.h"
+#include "osc.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Voltages the stubbed multiplexers report, indexed like pot_values[]
+// and cv_values[].
+extern float host_pots[NUM_POTS];
+extern float host_cv[NUM_CV];
+
+// Initializes the firmware exactly as main() does, minus the hardware.
+void HostInit(float sr = 48000.f, uint32_t seed = DEFAULT_PHASE_SEED);
+
+// Pushes host_pots[]/host_cv[] through the control graph immediately,
+// skipping the ADC smoothing.
+void HostApplyControls();
+
+// Runs the audio callback over `frames` samples, `block_size` at a time.
+void HostRender(float *left, float *right, size_t frames, size_t block_size);
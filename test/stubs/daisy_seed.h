@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// Copyright 2025 Tyler Reckart
+//
+// Author: Tyler Reckart (tyler.reckart@gmail.com)
+// ----------------------------------------------------------------------------
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+// ----------------------------------------------------------------------------
+#pragma once
+
+// Minimal stand-in for the parts of libDaisy the firmware touches, so the
+// DSP sources build and run on the host. Memory sections collapse to
+// ordinary statics.
+
+#include <cstddef>
+#include <cstdint>
+
+#define DSY_SDRAM_BSS
+#define DTCM_MEM_SECTION
+
+namespace daisy
+{
+struct Pin
+{
+    int port;
+    int pin;
+};
+
+namespace seed
+{
+extern const Pin D2, D3, D4, D5, A0, A1;
+}
+
+struct AdcChannelConfig
+{
+    void InitSingle(Pin pin) { this->pin = pin; }
+    Pin  pin;
+};
+
+struct AdcHandle
+{
+    void  Init(AdcChannelConfig *, size_t) {}
+    void  Start() {}
+    float GetFloat(uint8_t chn) const;
+};
+
+struct AudioHandle
+{
+    typedef const float *const *InputBuffer;
+    typedef float **            OutputBuffer;
+    typedef void (*AudioCallback)(InputBuffer  in,
+                                  OutputBuffer out,
+                                  size_t       size);
+};
+
+struct DaisySeed
+{
+    AdcHandle adc;
+    void      Init() {}
+    void      SetAudioBlockSize(size_t) {}
+    float     AudioSampleRate() { return 48000.f; }
+    void      StartAudio(AudioHandle::AudioCallback) {}
+};
+} // namespace daisy
+
+struct dsy_gpio
+{
+    daisy::Pin pin;
+    int        mode;
+};
+
+enum
+{
+    DSY_GPIO_MODE_OUTPUT_PP,
+};
+
+void dsy_gpio_init(dsy_gpio *p);
+void dsy_gpio_write(dsy_gpio *p, uint8_t state);